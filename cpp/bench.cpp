@@ -0,0 +1,333 @@
+/** **********************************************************************
+* @file
+* @brief contains benchmarks for the data structures used by the solver.
+*************************************************************************/
+#include "strands.h"
+#include <chrono>
+#include <random>
+#include <memory>
+
+
+/** **********************************************************************
+*  @brief
+*  Boards used by the benchmarks. All of them are real NYT Strands boards.
+************************************************************************/
+const vector<vector<string>> BENCH_BOARDS = {
+	{ "leaesp", "apcmae", "ikorrr", "retqro", "tgntus", "eieeir", "vremio", "skatrr" },
+	{ "rconna", "qoksav", "ueebir", "tnhaoi", "rejnpn", "aruods", "nsiorh", "eysaus" },
+	{ "euttel", "cnorke", "bckluy", "saceth", "maipct", "andwio", "ynnsma", "oaieto" }
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Larger custom boards made from the letters of the real boards. A 10x10
+*  board uses cells128_t and a 12x12 board uses DynamicCells.
+************************************************************************/
+const vector<vector<string>> BENCH_LARGE_BOARDS = {
+	{ "leaespapcm", "aeikorrrre", "tqrotgntus", "eieeirvrem", "ioskatrrrc",
+	  "onnaqoksav", "ueebirtnha", "oirejnpnar", "uodsnsiorh", "eysauseutt" },
+	{ "leaespapcmae", "ikorrrretqro", "tgntuseieeir", "vremioskatrr", "rconnaqoksav", "ueebirtnhaoi",
+	  "rejnpnaruods", "nsiorheysaus", "euttelcnorke", "bckluysaceth", "maipctandwio", "ynnsmaoaieto" }
+};
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the number of milliseconds since a point in time.
+ *
+ *  @param[in] start the point in time to measure from.
+ *
+ *  @returns milliseconds since start.
+************************************************************************/
+static double elapsed_ms( chrono::steady_clock::time_point start ) {
+	chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+	return ms.count();
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Compares lookups in a LetterNode prefix tree against lookups in the
+ *  flat minimized word graph of the Dictionary. Both answer the same
+ *  prefix queries, and both are walked one letter at a time the way the
+ *  word search does.
+ *
+ *  @param[in,out] out the ostream to print results to.
+************************************************************************/
+void bench_dictionary( ostream & out ) {
+
+	const int repeats = 5;
+
+	set<string> words;
+	LetterArena arena;
+	LetterNode prefix_tree;
+	get_words( words, prefix_tree, arena );
+
+	const Dictionary & dictionary = Dictionary::shared();
+
+	// every prefix of every word plus a near miss for every word
+	vector<string> queries;
+	for( auto & word : words ) {
+		for( size_t len = 1; len <= word.size(); len++ )
+			queries.push_back( word.substr( 0, len ) );
+		string miss = word;
+		miss.back() = static_cast<char>( 'a' + ( miss.back() - 'a' + 13 ) % 26 );
+		queries.push_back( miss );
+	}
+	shuffle( queries.begin(), queries.end(), mt19937( 137 ) );
+
+	vector<string> walks( words.begin(), words.end() );
+	shuffle( walks.begin(), walks.end(), mt19937( 137 ) );
+
+	size_t hits = 0;
+
+	auto start = chrono::steady_clock::now();
+	for( int r = 0; r < repeats; r++ )
+		for( auto & query : queries )
+			hits += prefix_tree.contains( query );
+	double trie_contains = elapsed_ms( start );
+
+	start = chrono::steady_clock::now();
+	for( int r = 0; r < repeats; r++ )
+		for( auto & query : queries )
+			hits += dictionary.has_prefix( query );
+	double flat_contains = elapsed_ms( start );
+
+	size_t steps = 0;
+
+	start = chrono::steady_clock::now();
+	for( int r = 0; r < repeats; r++ ) {
+		for( auto & word : walks ) {
+			const LetterNode * ln = &prefix_tree;
+			for( auto c : word ) {
+				ln = ln->children[ LetterNode::char_to_index( c ) ];
+				steps++;
+			}
+			hits += ln->terminal;
+		}
+	}
+	double trie_walk = elapsed_ms( start );
+
+	start = chrono::steady_clock::now();
+	for( int r = 0; r < repeats; r++ ) {
+		for( auto & word : walks ) {
+			uint32_t node = dictionary.root();
+			for( auto c : word )
+				node = dictionary.child( node, c );
+			hits += dictionary.is_word( node );
+		}
+	}
+	double flat_walk = elapsed_ms( start );
+
+	double lookups = double( queries.size() ) * repeats;
+
+	out << left << fixed << setprecision( 1 )
+		<< "Dictionary lookups (" << hits << " hits)\n"
+		<< setw( 36 ) << "  LetterNode::contains"
+		<< trie_contains * 1e6 / lookups << " ns per prefix\n"
+		<< setw( 36 ) << "  Dictionary::has_prefix"
+		<< flat_contains * 1e6 / lookups << " ns per prefix\n"
+		<< setw( 36 ) << "  LetterNode child steps"
+		<< trie_walk * 1e6 / double( steps ) << " ns per letter\n"
+		<< setw( 36 ) << "  Dictionary::child steps"
+		<< flat_walk * 1e6 / double( steps ) << " ns per letter\n\n";
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Times StrandsBoard::find_all_words on fresh copies of a board. The
+ *  words found on a board are kept until its text changes, so searching
+ *  the same board again would only time the first search. The boards
+ *  are made before the clock starts.
+ *
+ *  @param[in] board_string the text of the board.
+ *  @param[in] engine the search to time.
+ *  @param[in] threads the number of threads to search with.
+ *  @param[in] repeats how many boards to search.
+ *  @param[out] words the number of words found on the board.
+ *
+ *  @returns the milliseconds spent searching all of the boards.
+************************************************************************/
+double time_fresh_search( vector<string> board_string, SearchEngine engine, int threads, int repeats, int & words ) {
+
+	vector<unique_ptr<StrandsBoard>> copies;
+	for( int r = 0; r < repeats; r++ ) {
+		copies.push_back( make_unique<StrandsBoard>( board_string ) );
+		copies.back()->search_engine = engine;
+		copies.back()->search_threads = threads;
+	}
+
+	auto start = chrono::steady_clock::now();
+	for( auto & board : copies )
+		board->find_all_words();
+	double ms = elapsed_ms( start );
+
+	words = copies.back()->get_found_words_amount();
+	return ms;
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Times StrandsBoard::find_all_words on each of the benchmark boards,
+ *  with the recursive and the iterative search on a single thread and
+ *  then with the iterative search on one thread per core.
+ *
+ *  @param[in,out] out the ostream to print results to.
+************************************************************************/
+void bench_search( ostream & out ) {
+
+	const int repeats = 20;
+
+	out << "StrandsBoard::find_all_words\n";
+
+	vector<vector<string>> boards = BENCH_BOARDS;
+	boards.insert( boards.end(), BENCH_LARGE_BOARDS.begin(), BENCH_LARGE_BOARDS.end() );
+
+	for( auto board_string : boards ) {
+
+		int words;
+		double recursive_ms = time_fresh_search( board_string, SEARCH_RECURSIVE, 1, repeats, words );
+		double ms = time_fresh_search( board_string, SEARCH_ITERATIVE, 1, repeats, words );
+		double parallel_ms = time_fresh_search( board_string, SEARCH_ITERATIVE, 0, repeats, words );
+
+		out << left << fixed << setprecision( 3 ) << "  " << setw( 34 )
+			<< board_string[0] + "..." << recursive_ms / repeats << " ms recursive, "
+			<< ms / repeats << " ms iterative, " << parallel_ms / repeats << " ms on " << thread::hardware_concurrency()
+			<< " threads, " << words << " words\n";
+
+	}
+
+	out << "\n";
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Times StrandsBoard::find_longest_words keeping the 10 longest words
+ *  against StrandsBoard::find_all_words on each of the benchmark boards.
+ *
+ *  @param[in,out] out the ostream to print results to.
+************************************************************************/
+void bench_longest( ostream & out ) {
+
+	const int repeats = 20;
+	const int amount = 10;
+
+	out << "StrandsBoard::find_longest_words( " << amount << " )\n";
+
+	vector<vector<string>> boards = BENCH_BOARDS;
+	boards.insert( boards.end(), BENCH_LARGE_BOARDS.begin(), BENCH_LARGE_BOARDS.end() );
+
+	for( auto board_string : boards ) {
+
+		int words;
+		double all_ms = time_fresh_search( board_string, SEARCH_ITERATIVE, 1, repeats, words );
+
+		StrandsBoard board( board_string );
+
+		auto start = chrono::steady_clock::now();
+		for( int r = 0; r < repeats; r++ )
+			board.find_longest_words( amount );
+		double ms = elapsed_ms( start );
+
+		out << left << fixed << setprecision( 3 ) << "  " << setw( 34 )
+			<< board_string[0] + "..." << ms / repeats << " ms, "
+			<< all_ms / repeats << " ms for every word, longest is "
+			<< board.found_words[0].word << "\n";
+
+	}
+
+	out << "\n";
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Times StrandsBoard::find_solution_from_words with each solve engine
+ *  on the real benchmark boards, then with the bitmask engine on one 
+ *  thread per core and with the bitmask engine only looking for 
+ *  solutions with one spangram. All of them give up after a million 
+ *  calls, so the number of solutions found matters as much as the time.
+ *
+ *  @param[in,out] out the ostream to print results to.
+************************************************************************/
+void bench_solve( ostream & out ) {
+
+	const SolveEngine engines[] = { SOLVE_BITMASK, SOLVE_DANCING_LINKS, SOLVE_BITMASK, SOLVE_BITMASK };
+	const int threads[] = { 1, 1, 0, 1 };
+	const bool one_spangram[] = { false, false, false, true };
+	const string names[] = { "bitmask", "dancing links", 
+		"bitmask on " + to_string( thread::hardware_concurrency() ) + " threads", 
+		"bitmask with one spangram" };
+
+	out << "StrandsBoard::find_solution_from_words\n";
+
+	for( auto board_string : BENCH_BOARDS ) {
+
+		StrandsBoard board( board_string );
+		board.find_all_words();
+
+		out << "  " << board_string[0] << "...\n";
+
+		for( int e = 0; e < 4; e++ ) {
+
+			board.solve_engine = engines[e];
+			board.solve_threads = threads[e];
+			board.solve_options.one_spangram = one_spangram[e];
+
+			auto start = chrono::steady_clock::now();
+			board.find_solution_from_words();
+			double ms = elapsed_ms( start );
+
+			out << left << fixed << setprecision( 3 ) << "    " << setw( 32 )
+				<< names[e] << ms << " ms, " << board.get_solution_amount() 
+				<< " solutions\n";
+
+		}
+
+	}
+
+	out << "\n";
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Runs every benchmark and prints the results.
+ *
+ *  @returns 0 once the benchmarks finish.
+************************************************************************/
+int main() {
+
+	bench_dictionary( std::cout );
+
+	bench_search( std::cout );
+
+	bench_longest( std::cout );
+
+	bench_solve( std::cout );
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+/** **********************************************************************
+* @file
+* @brief contains implementation of the DynamicCells class and the set of
+* positions helpers for it.
+*************************************************************************/
+#include "strands.h"
+
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Default constructor. The set holds no positions and has no room for
+ *  any.
+************************************************************************/
+DynamicCells::DynamicCells() {
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Constructs an empty set with room for every position on a board.
+ *
+ *  @param[in] size the number of cells on the board.
+ *
+ *  @par Example
+ *  @verbatim
+
+    DynamicCells covered( width * height );
+
+    @endverbatim
+************************************************************************/
+DynamicCells::DynamicCells( int size ) : blocks( ( size + 63 ) / 64, 0 ) {
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Adds a position to the set.
+ *
+ *  @param[in] cell the position to add, stored as x + width * y.
+************************************************************************/
+void DynamicCells::set( int cell ) {
+	blocks[ cell / 64 ] |= uint64_t( 1 ) << ( cell % 64 );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Removes a position from the set.
+ *
+ *  @param[in] cell the position to remove, stored as x + width * y.
+************************************************************************/
+void DynamicCells::reset( int cell ) {
+	blocks[ cell / 64 ] &= ~( uint64_t( 1 ) << ( cell % 64 ) );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if a position is in the set.
+ *
+ *  @param[in] cell the position to check, stored as x + width * y.
+ *
+ *  @returns true if the position is in the set.
+************************************************************************/
+bool DynamicCells::test( int cell ) const {
+	return ( blocks[ cell / 64 ] >> ( cell % 64 ) ) & 1;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if two sets for the same board have any position in common.
+ *
+ *  @param[in] other the other set.
+ *
+ *  @returns true if some position is in both sets.
+************************************************************************/
+bool DynamicCells::intersects( const DynamicCells & other ) const {
+	for( size_t i = 0; i < blocks.size(); i++ )
+		if ( blocks[i] & other.blocks[i] ) return true;
+	return false;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Adds every position of another set for the same board to this one.
+ *
+ *  @param[in] other the set to add.
+ *
+ *  @returns a reference to this set.
+************************************************************************/
+DynamicCells & DynamicCells::operator |=( const DynamicCells & other ) {
+	for( size_t i = 0; i < blocks.size(); i++ )
+		blocks[i] |= other.blocks[i];
+	return *this;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Flips every position of another set for the same board in this one.
+ *  Removes the other set when it is already contained in this one.
+ *
+ *  @param[in] other the set to flip.
+ *
+ *  @returns a reference to this set.
+************************************************************************/
+DynamicCells & DynamicCells::operator ^=( const DynamicCells & other ) {
+	for( size_t i = 0; i < blocks.size(); i++ )
+		blocks[i] ^= other.blocks[i];
+	return *this;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if two sets hold exactly the same positions.
+ *
+ *  @param[in] other the set to compare with.
+ *
+ *  @returns true if the sets are equal.
+************************************************************************/
+bool DynamicCells::operator ==( const DynamicCells & other ) const {
+	return blocks == other.blocks;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Mixes the positions in the set down to a hash value. Equal sets
+ *  have equal hashes.
+ *
+ *  @returns the hash value.
+************************************************************************/
+size_t DynamicCells::hash() const {
+	size_t h = 0;
+	for( auto block : blocks )
+		h = ( h ^ hash_cells( block ) ) * 0x100000001b3ull;
+	return h;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns an empty DynamicCells with room for every position on a board.
+ *
+ *  @param[in] size the number of cells on the board.
+ *
+ *  @returns the empty set.
+************************************************************************/
+template <>
+DynamicCells no_cells<DynamicCells>( int size ) {
+	return DynamicCells( size );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Adds a position to a DynamicCells.
+ *
+ *  @param[in,out] cells the set to add to.
+ *  @param[in] cell the position to add.
+************************************************************************/
+void set_cell( DynamicCells & cells, int cell ) {
+	cells.set( cell );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Removes a position from a DynamicCells.
+ *
+ *  @param[in,out] cells the set to remove from.
+ *  @param[in] cell the position to remove.
+************************************************************************/
+void reset_cell( DynamicCells & cells, int cell ) {
+	cells.reset( cell );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if a position is in a DynamicCells.
+ *
+ *  @param[in] cells the set to check.
+ *  @param[in] cell the position to check.
+ *
+ *  @returns true if the position is in the set.
+************************************************************************/
+bool test_cell( const DynamicCells & cells, int cell ) {
+	return cells.test( cell );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if two DynamicCells have any position in common.
+ *
+ *  @param[in] a the first set.
+ *  @param[in] b the second set.
+ *
+ *  @returns true if some position is in both sets.
+************************************************************************/
+bool cells_intersect( const DynamicCells & a, const DynamicCells & b ) {
+	return a.intersects( b );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Mixes a DynamicCells down to a hash value.
+ *
+ *  @param[in] cells the set to hash.
+ *
+ *  @returns the hash value.
+************************************************************************/
+size_t hash_cells( const DynamicCells & cells ) {
+	return cells.hash();
+}
@@ -0,0 +1,41 @@
+/** **********************************************************************
+* @file
+* @brief contains the command line tool that precompiles the words file.
+*************************************************************************/
+#include "strands.h"
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Turns the plain text words file into a precompiled dictionary which
+ *  the solver memory maps at startup instead of parsing the words file.
+ *  The input and output locations may be given as arguments and default
+ *  to words and words.dict.
+ *
+ *  @param[in] argc the number of arguments.
+ *  @param[in] argv the arguments.
+ *
+ *  @returns 0 if the dictionary was written, 1 if not.
+ *
+ *  @par Example
+ *  @verbatim
+
+    ./compile_words.o words words.dict
+
+    @endverbatim
+************************************************************************/
+int main( int argc, char ** argv ) {
+
+	const char * text_path = argc > 1 ? argv[1] : DICTIONARY_TEXT_FILE;
+	const char * binary_path = argc > 2 ? argv[2] : DICTIONARY_BINARY_FILE;
+
+	if ( !Dictionary::compile( text_path, binary_path ) ) {
+		std::cerr << "Failed to write " << binary_path << "\n";
+		return 1;
+	}
+
+	std::cout << "Wrote " << binary_path << "\n";
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+/** **********************************************************************
+* @file
+* @brief contains implementation of the DancingLinks exact cover solver.
+*************************************************************************/
+#include "strands.h"
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Constructs an exact cover problem with a number of columns and no
+ *  rows yet. Every column has to be covered by a solution. Secondary 
+ *  columns come after them and only have to be covered at most once, 
+ *  so they keep rows from being chosen together.
+ *
+ *  @param[in] columns the number of columns.
+ *  @param[in] secondary the number of secondary columns.
+ *
+ *  @par Example
+ *  @verbatim
+
+    // one column per letter of the board
+    DancingLinks links( size() );
+
+    @endverbatim
+************************************************************************/
+DancingLinks::DancingLinks( int columns, int secondary ) {
+
+	primary_columns = columns;
+	columns_left = columns;
+	shortest_row = numeric_limits<int>::max();
+	longest_row = 0;
+
+	// the root and the column headers form a circular list
+	for( int c = 0; c <= columns; c++ ) {
+		left.push_back( c == 0 ? columns : c - 1 );
+		right.push_back( c == columns ? 0 : c + 1 );
+		up.push_back( c );
+		down.push_back( c );
+		column.push_back( c );
+		row.push_back( -1 );
+		column_size.push_back( 0 );
+	}
+
+	// secondary headers link to themselves so the search never picks them
+	for( int c = columns + 1; c <= columns + secondary; c++ ) {
+		left.push_back( c );
+		right.push_back( c );
+		up.push_back( c );
+		down.push_back( c );
+		column.push_back( c );
+		row.push_back( -1 );
+		column_size.push_back( 0 );
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Adds a row covering some columns to the problem.
+ *
+ *  @param[in] row_id the id reported in solutions for this row.
+ *  @param[in] columns the columns the row covers, numbered from 0.
+ *
+ *  @par Example
+ *  @verbatim
+
+    for( size_t i = 0; i < found_words.size(); i++ )
+		links.add_row( int( i ), columns_of_word[i] );
+
+    @endverbatim
+************************************************************************/
+void DancingLinks::add_row( int row_id, const vector<int> & columns ) {
+
+	int first = static_cast<int>( left.size() );
+
+	int primary = static_cast<int>( count_if( columns.begin(), columns.end(), [this]( int c ) { return c < primary_columns; } ) );
+	shortest_row = min( shortest_row, primary );
+	longest_row = max( longest_row, primary );
+
+	for( size_t i = 0; i < columns.size(); i++ ) {
+
+		int node = static_cast<int>( left.size() );
+		int header = columns[i] + 1;
+
+		// link the node into the row, which is circular
+		left.push_back( i == 0 ? node : node - 1 );
+		right.push_back( first );
+		if ( i > 0 ) right[ node - 1 ] = node;
+		left[ first ] = node;
+
+		// and at the bottom of its column
+		up.push_back( up[ header ] );
+		down.push_back( header );
+		down[ up[ header ] ] = node;
+		up[ header ] = node;
+
+		column.push_back( header );
+		row.push_back( row_id );
+		column_size[ header ]++;
+
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Removes a column from the header list and every row covering it from
+ *  the other columns.
+ *
+ *  @param[in] c the header node of the column.
+************************************************************************/
+void DancingLinks::cover( int c ) {
+
+	right[ left[c] ] = right[c];
+	left[ right[c] ] = left[c];
+	if ( c <= primary_columns ) columns_left--;
+
+	for( int i = down[c]; i != c; i = down[i] ) {
+		for( int j = right[i]; j != i; j = right[j] ) {
+			down[ up[j] ] = down[j];
+			up[ down[j] ] = up[j];
+			column_size[ column[j] ]--;
+		}
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Undoes DancingLinks::cover. Columns have to be uncovered in the
+ *  opposite order they were covered in.
+ *
+ *  @param[in] c the header node of the column.
+************************************************************************/
+void DancingLinks::uncover( int c ) {
+
+	for( int i = up[c]; i != c; i = up[i] ) {
+		for( int j = left[i]; j != i; j = left[j] ) {
+			column_size[ column[j] ]++;
+			down[ up[j] ] = j;
+			up[ down[j] ] = j;
+		}
+	}
+
+	right[ left[c] ] = c;
+	left[ right[c] ] = c;
+	if ( c <= primary_columns ) columns_left++;
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds every set of rows that covers each column exactly once. The
+ *  search always continues from the column with the fewest rows left, 
+ *  so a column no row can cover ends the branch right away, as does a 
+ *  branch whose columns left can't be covered with an allowed number of
+ *  rows given the lengths of the shortest and longest rows. The search
+ *  gives up once the budget runs out.
+ *
+ *  @param[out] solutions each solution found is added as the row ids of
+ *  its rows in increasing order.
+ *  @param[in,out] budget the limits on the search.
+ *  @param[in] min_rows the fewest rows a solution may have.
+ *  @param[in] max_rows the most rows a solution may have.
+ *
+ *  @par Example
+ *  @verbatim
+
+    SolveBudget budget( solve_options );
+    links.search( solutions, budget, 0, numeric_limits<int>::max() );
+
+    @endverbatim
+************************************************************************/
+void DancingLinks::search( vector<vector<int>> & solutions, SolveBudget & budget, int min_rows, int max_rows ) {
+	chosen.clear();
+	search_rec( solutions, budget, min_rows, max_rows );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Does the recursive work of DancingLinks::search.
+ *
+ *  @param[out] solutions the solutions found so far.
+ *  @param[in,out] budget the limits on the search.
+ *  @param[in] min_rows the fewest rows a solution may have.
+ *  @param[in] max_rows the most rows a solution may have.
+************************************************************************/
+void DancingLinks::search_rec( vector<vector<int>> & solutions, SolveBudget & budget, int min_rows, int max_rows ) {
+
+	if ( budget.spent() ) return;
+	budget.spend();
+
+	// every column is covered
+	if ( right[0] == 0 ) {
+		if ( int( chosen.size() ) < min_rows ) return;
+		solutions.push_back( chosen );
+		sort( solutions.back().begin(), solutions.back().end() );
+		budget.add_solution();
+		return;
+	}
+
+	// no rows can cover the columns left
+	if ( longest_row == 0 ) return;
+
+	// the columns left take at least as many rows as they would with only
+	// the longest row and at most as many as with only the shortest
+	int rows = static_cast<int>( chosen.size() );
+	if ( ( columns_left + longest_row - 1 ) / longest_row > max_rows - rows 
+		|| columns_left / shortest_row < min_rows - rows ) return;
+
+	// pick the column with the fewest rows left
+	int best = right[0];
+	for( int c = right[ best ]; c != 0; c = right[c] )
+		if ( column_size[c] < column_size[ best ] ) best = c;
+
+	if ( column_size[ best ] == 0 ) return;
+
+	cover( best );
+
+	for( int r = down[ best ]; r != best && !budget.spent(); r = down[r] ) {
+
+		chosen.push_back( row[r] );
+		for( int j = right[r]; j != r; j = right[j] )
+			cover( column[j] );
+
+		search_rec( solutions, budget, min_rows, max_rows );
+
+		for( int j = left[r]; j != r; j = left[j] )
+			uncover( column[j] );
+		chosen.pop_back();
+
+	}
+
+	uncover( best );
+
+}
@@ -0,0 +1,715 @@
+/** **********************************************************************
+* @file
+* @brief contains implementation of the Dictionary class.
+*************************************************************************/
+#include "strands.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <map>
+
+
+/** **********************************************************************
+*  @brief
+*  Magic number at the start of a precompiled dictionary ("STRD").
+************************************************************************/
+const uint32_t DICT_MAGIC = 0x44525453u;
+
+/** **********************************************************************
+*  @brief
+*  Version of the precompiled dictionary layout. Files with a different
+*  version are ignored and the words file is parsed instead.
+************************************************************************/
+const uint32_t DICT_VERSION = 2;
+
+/** **********************************************************************
+*  @brief
+*  Header of a precompiled dictionary file. It is followed directly by
+*  node_count DictNode structs. Everything is stored in the byte order
+*  of the machine that compiled it.
+************************************************************************/
+struct DictHeader {
+
+	uint32_t magic;
+    /**< Always DICT_MAGIC. */
+
+	uint32_t version;
+    /**< Always DICT_VERSION. */
+
+	uint32_t node_count;
+    /**< Number of nodes following the header. */
+
+	uint32_t word_count;
+    /**< Number of words in the dictionary. */
+
+};
+
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Recursively merges every subtree of a LetterNode prefix tree with any
+ *  identical subtree seen before, turning the tree into a minimized
+ *  directed acyclic word graph. Each distinct node is described by a 
+ *  signature whose first item is its DictNode mask and whose other items
+ *  are the ids of its children in alphabetical order. The mask includes
+ *  the height of the node, the most letters that can follow it, which
+ *  is the same for identical subtrees.
+ *
+ *  @param[in] ln the LetterNode to minimize.
+ *  @param[in,out] registry maps each signature seen so far to its id.
+ *  @param[in,out] graph the signature of each distinct node by id.
+ *
+ *  @returns the id of the node equivalent to ln.
+ *
+ *  @par Example
+ *  @verbatim
+
+    map<vector<uint32_t>, uint32_t> registry;
+	vector<vector<uint32_t>> graph;
+	uint32_t root = minimize( prefix_tree, registry, graph );
+
+    @endverbatim
+************************************************************************/
+static uint32_t minimize( 
+	const LetterNode & ln, 
+	map<vector<uint32_t>, uint32_t> & registry, 
+	vector<vector<uint32_t>> & graph 
+) {
+
+	vector<uint32_t> signature( 1, ln.terminal ? DICT_TERMINAL : 0 );
+	uint32_t height = 0;
+	for( int i = 0; i < 26; i++ ) {
+		if ( ln.children[i] == nullptr ) continue;
+		signature[0] |= 1u << i;
+		uint32_t id = minimize( *ln.children[i], registry, graph );
+		height = max( height, min( ( graph[id][0] >> DICT_HEIGHT_SHIFT ) + 1, DICT_HEIGHT_MAX ) );
+		signature.push_back( id );
+	}
+	signature[0] |= height << DICT_HEIGHT_SHIFT;
+
+	// reuse an identical node if there is one
+	auto found = registry.find( signature );
+	if ( found != registry.end() ) return found->second;
+
+	uint32_t id = static_cast<uint32_t>( graph.size() );
+	registry.emplace( signature, id );
+	graph.push_back( signature );
+
+	return id;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Decides where the block of children of every node of the minimized
+ *  word graph goes in the flat array. Blocks are laid out breadth first
+ *  so the nodes near the root, which every search goes through, end up
+ *  next to each other and share cache lines.
+ *
+ *  @param[in] root_id the id of the root of the graph.
+ *  @param[in] graph the signature of each distinct node by id.
+ *  @param[out] order the ids of the nodes in the order they are laid out.
+ *  @param[out] block_start the index of the first child of each node.
+ *
+ *  @returns the number of nodes the flat array needs.
+************************************************************************/
+static uint32_t layout_breadth_first( 
+	uint32_t root_id, 
+	const vector<vector<uint32_t>> & graph, 
+	vector<uint32_t> & order,
+	vector<uint32_t> & block_start 
+) {
+
+	vector<bool> queued( graph.size(), false );
+	block_start.assign( graph.size(), DICT_NO_NODE );
+
+	order.clear();
+	order.push_back( root_id );
+	queued[ root_id ] = true;
+
+	// the root itself takes up the first node
+	uint32_t next = 1;
+
+	// order doubles as the queue
+	for( size_t i = 0; i < order.size(); i++ ) {
+		const vector<uint32_t> & signature = graph[ order[i] ];
+		block_start[ order[i] ] = next;
+		next += static_cast<uint32_t>( signature.size() - 1 );
+
+		for( size_t j = 1; j < signature.size(); j++ ) {
+			if ( queued[ signature[j] ] ) continue;
+			queued[ signature[j] ] = true;
+			order.push_back( signature[j] );
+		}
+	}
+
+	return next;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the dictionary shared by the whole process. The words file is
+ *  read the first time this is called and never again. Initialization of
+ *  a function local static is thread safe so boards may be constructed
+ *  from several threads at once.
+ *
+ *  @returns a reference to the shared dictionary.
+ *
+ *  @par Example
+ *  @verbatim
+
+    StrandsBoard::StrandsBoard() : dictionary( Dictionary::shared() ) {
+		width = 6;
+		height = 8;
+		allocate();
+	}
+
+    @endverbatim
+************************************************************************/
+const Dictionary & Dictionary::shared() {
+	static const Dictionary instance;
+	return instance;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Constructs a dictionary. The precompiled dictionary is memory mapped
+ *  if it exists and is valid, otherwise the words file is parsed. Prefer
+ *  Dictionary::shared over constructing a new one.
+************************************************************************/
+Dictionary::Dictionary() {
+	nodes = nullptr;
+	node_count = 0;
+	word_count = 0;
+	mapping = nullptr;
+	mapping_size = 0;
+
+	if ( !load_binary( DICTIONARY_BINARY_FILE ) )
+		load_text( DICTIONARY_TEXT_FILE );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Constructs a dictionary holding only the words of another dictionary
+ *  that could be spelled on a board: each letter has to appear in the 
+ *  word no more often than it appears on the board, and every pair
+ *  of letters next to each other in the word has to appear next to each
+ *  other somewhere on the board. Most words fail one of the two, so 
+ *  searching the board with this dictionary runs into fewer dead ends.
+ *  The nodes are not minimized since they are only used by one board.
+ *
+ *  @param[in] source the dictionary to take words from.
+ *  @param[in] letters the letters of the board.
+ *
+ *  @par Example
+ *  @verbatim
+
+	board_dictionary = make_unique<Dictionary>( dictionary, letters );
+
+    @endverbatim
+************************************************************************/
+Dictionary::Dictionary( const Dictionary & source, const BoardLetters & letters ) {
+	mapping = nullptr;
+	mapping_size = 0;
+	word_count = 0;
+
+	int counts[26];
+	copy( letters.counts, letters.counts + 26, counts );
+
+	// the root always takes up the first node
+	storage.assign( 1, DictNode() );
+	DictNode root = copy_fitting( source, source.root(), -1, letters, counts );
+	storage[0] = root;
+
+	nodes = storage.data();
+	node_count = static_cast<uint32_t>( storage.size() );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Recursively copies the part of the subtree of a node of another 
+ *  dictionary that fits the letters of a board into storage. The
+ *  children of the node are copied first so they end up next to each
+ *  other, then the node itself is returned for the caller to place.
+ *
+ *  @param[in] source the dictionary being copied.
+ *  @param[in] node the node of source to copy.
+ *  @param[in] previous the letter leading to node as 0 to 25, or -1 for
+ *  the root.
+ *  @param[in] letters the letters of the board.
+ *  @param[in,out] counts how many of each letter are left on the board
+ *  after spelling the prefix of node.
+ *
+ *  @returns the copied node, with no letters and no DICT_TERMINAL if no
+ *  word below it fits.
+************************************************************************/
+DictNode Dictionary::copy_fitting( 
+	const Dictionary & source, 
+	uint32_t node, 
+	int previous, 
+	const BoardLetters & letters, 
+	int * counts 
+) {
+
+	DictNode copied;
+	copied.mask = source.nodes[ node ].mask & DICT_TERMINAL;
+	copied.first = DICT_NO_NODE;
+	if ( copied.mask ) word_count++;
+
+	// only letters left on the board that can follow the previous one
+	uint32_t allowed = previous < 0 ? DICT_LETTER_BITS : letters.follows[ previous ];
+
+	DictNode children[26];
+	int copied_children = 0;
+	uint32_t height = 0;
+
+	uint32_t child = source.nodes[ node ].first;
+	for( uint32_t rest = source.nodes[ node ].mask & DICT_LETTER_BITS; rest; rest &= rest - 1, child++ ) {
+
+		int c = countr_zero( rest );
+		if ( !( allowed & ( 1u << c ) ) || counts[c] == 0 ) continue;
+
+		counts[c]--;
+		DictNode grandchild = copy_fitting( source, child, c, letters, counts );
+		counts[c]++;
+
+		// skip letters with no word below them
+		if ( ( grandchild.mask & ( DICT_LETTER_BITS | DICT_TERMINAL ) ) == 0 ) continue;
+
+		copied.mask |= 1u << c;
+		height = max( height, min( ( grandchild.mask >> DICT_HEIGHT_SHIFT ) + 1, DICT_HEIGHT_MAX ) );
+		children[ copied_children++ ] = grandchild;
+
+	}
+
+	if ( copied_children > 0 ) {
+		copied.first = static_cast<uint32_t>( storage.size() );
+		storage.insert( storage.end(), children, children + copied_children );
+	}
+	copied.mask |= height << DICT_HEIGHT_SHIFT;
+
+	return copied;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Unmaps the precompiled dictionary if one was mapped.
+************************************************************************/
+Dictionary::~Dictionary() {
+	if ( mapping != nullptr )
+		munmap( mapping, mapping_size );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Parses a words file and writes it out as a precompiled dictionary
+ *  that can later be memory mapped without any parsing. A report of
+ *  how much memory the dictionary takes as a minimized word graph 
+ *  compared to a LetterNode prefix tree and set of strings is printed.
+ *
+ *  The dictionary is written to a temporary file next to binary_path
+ *  and then renamed over it, so a process that already mapped the old
+ *  file keeps reading it whole instead of seeing it truncated.
+ *
+ *  @param[in] text_path the location of the words file.
+ *  @param[in] binary_path where to write the precompiled dictionary.
+ *  @param[in,out] out the ostream to print the memory report to.
+ *
+ *  @returns true if the dictionary was written, false if not.
+ *
+ *  @par Example
+ *  @verbatim
+
+    if ( !Dictionary::compile( "words", "words.dict" ) )
+		std::cerr << "Failed to write words.dict\n";
+
+    @endverbatim
+************************************************************************/
+bool Dictionary::compile( const char * text_path, const char * binary_path, ostream & out ) {
+
+	set<string> words;
+	LetterArena arena;
+	LetterNode prefix_tree;
+	get_words( words, prefix_tree, arena, text_path );
+
+	vector<DictNode> flat;
+	build( prefix_tree, flat );
+
+	// estimate what the words used to cost in memory. a set node holds
+	// three pointers and a color, and long strings live on the heap
+	size_t trie_nodes = arena.size() + 1;
+	size_t trie_bytes = trie_nodes * sizeof( LetterNode );
+	size_t set_bytes = words.size() * ( 4 * sizeof( void * ) + sizeof( string ) );
+	for( auto & word : words )
+		if ( word.size() >= sizeof( string ) / 2 ) set_bytes += word.size() + 1;
+	size_t graph_bytes = sizeof( DictHeader ) + flat.size() * sizeof( DictNode );
+
+	out << left
+		<< setw( 28 ) << "Words" << words.size() << "\n"
+		<< setw( 28 ) << "LetterNode prefix tree" << trie_nodes << " nodes, " 
+		<< trie_bytes << " bytes\n"
+		<< setw( 28 ) << "Set of words" << "about " << set_bytes << " bytes\n"
+		<< setw( 28 ) << "Minimized word graph" << flat.size() << " nodes, " 
+		<< graph_bytes << " bytes\n"
+		<< setw( 28 ) << "Reduction" << fixed << setprecision( 1 ) 
+		<< double( trie_bytes + set_bytes ) / double( graph_bytes ) << "x\n";
+
+	DictHeader header;
+	header.magic = DICT_MAGIC;
+	header.version = DICT_VERSION;
+	header.node_count = static_cast<uint32_t>( flat.size() );
+	header.word_count = static_cast<uint32_t>( words.size() );
+
+	string temp_path = string( binary_path ) + ".tmp" + to_string( getpid() );
+	ofstream file( temp_path, ios::binary );
+	if ( !file.is_open() ) return false;
+
+	file.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+	file.write( 
+		reinterpret_cast<const char *>( flat.data() ), 
+		flat.size() * sizeof( DictNode ) 
+	);
+	file.close();
+
+	if ( !file.good() || rename( temp_path.c_str(), binary_path ) != 0 ) {
+		remove( temp_path.c_str() );
+		return false;
+	}
+
+	return true;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Memory maps a precompiled dictionary and uses the nodes in place.
+ *
+ *  @param[in] path the location of the precompiled dictionary.
+ *
+ *  @returns true if the file was mapped, false if it is missing, was
+ *  not made by the current version of compile_words, or has a node 
+ *  whose children lie past the end of the file.
+************************************************************************/
+bool Dictionary::load_binary( const char * path ) {
+
+	int fd = open( path, O_RDONLY );
+	if ( fd < 0 ) return false;
+
+	struct stat info;
+	if ( fstat( fd, &info ) != 0 
+	|| static_cast<size_t>( info.st_size ) < sizeof( DictHeader ) ) {
+		close( fd );
+		return false;
+	}
+
+	size_t file_size = static_cast<size_t>( info.st_size );
+	void * map = mmap( nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	// the mapping stays valid after the file is closed
+	close( fd );
+	if ( map == MAP_FAILED ) return false;
+
+	// make sure the file is one we know how to read
+	const DictHeader * header = static_cast<const DictHeader *>( map );
+	if ( header->magic != DICT_MAGIC || header->version != DICT_VERSION 
+	|| header->node_count == 0
+	|| file_size != sizeof( DictHeader ) + header->node_count * sizeof( DictNode ) ) {
+		munmap( map, file_size );
+		return false;
+	}
+
+	// a stale or damaged file could point children past the last node
+	const DictNode * file_nodes = reinterpret_cast<const DictNode *>( header + 1 );
+	for( uint32_t i = 0; i < header->node_count; i++ ) {
+		uint32_t children = popcount( file_nodes[i].mask & DICT_LETTER_BITS );
+		if ( children == 0 ) continue;
+		if ( file_nodes[i].first == DICT_NO_NODE 
+		|| uint64_t( file_nodes[i].first ) + children > header->node_count ) {
+			munmap( map, file_size );
+			return false;
+		}
+	}
+
+	mapping = map;
+	mapping_size = file_size;
+	nodes = file_nodes;
+	node_count = header->node_count;
+	word_count = static_cast<int>( header->word_count );
+
+	return true;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Parses the words file and builds the flat prefix tree in memory.
+ *
+ *  @param[in] path the location of the words file.
+************************************************************************/
+void Dictionary::load_text( const char * path ) {
+
+	set<string> words;
+	LetterArena arena;
+	LetterNode prefix_tree;
+	get_words( words, prefix_tree, arena, path );
+
+	build( prefix_tree, storage );
+
+	nodes = storage.data();
+	node_count = static_cast<uint32_t>( storage.size() );
+	word_count = static_cast<int>( words.size() );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Converts a LetterNode prefix tree into the flat minimized word graph
+ *  used by the Dictionary. Identical subtrees such as common endings
+ *  are stored only once. The root is always the first node and the rest
+ *  are laid out breadth first.
+ *
+ *  @param[in] root the root of the prefix tree.
+ *  @param[out] flat the array of nodes.
+ *
+ *  @par Example
+ *  @verbatim
+
+    set<string> words;
+	LetterArena arena;
+	LetterNode prefix_tree;
+	get_words( words, prefix_tree, arena, path );
+
+	build( prefix_tree, storage );
+	nodes = storage.data();
+
+    @endverbatim
+************************************************************************/
+void Dictionary::build( const LetterNode & root, vector<DictNode> & flat ) {
+
+	map<vector<uint32_t>, uint32_t> registry;
+	vector<vector<uint32_t>> graph;
+	uint32_t root_id = minimize( root, registry, graph );
+
+	vector<uint32_t> order;
+	vector<uint32_t> block_start;
+	flat.assign( layout_breadth_first( root_id, graph, order, block_start ), DictNode() );
+
+	flat[0].mask = graph[ root_id ][0];
+	flat[0].first = block_start[ root_id ];
+
+	// fill in the block of children of every node
+	for( auto id : order ) {
+		const vector<uint32_t> & signature = graph[ id ];
+		for( size_t j = 1; j < signature.size(); j++ ) {
+			DictNode & node = flat[ block_start[ id ] + j - 1 ];
+			node.mask = graph[ signature[j] ][0];
+			node.first = block_start[ signature[j] ];
+		}
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Walks the prefix tree along a word.
+ *
+ *  @param[in] word the word or prefix to walk along.
+ *
+ *  @returns the index of the node of the last letter of the word or 
+ *  DICT_NO_NODE if no word starts with it.
+************************************************************************/
+uint32_t Dictionary::find( const string & word ) const {
+	uint32_t node = root();
+	for( auto c : word ) {
+		node = child( node, c );
+		if ( node == DICT_NO_NODE ) return DICT_NO_NODE;
+	}
+	return node;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if any word in the dictionary starts with a prefix.
+ *
+ *  @param[in] prefix the prefix to look for.
+ *
+ *  @returns true if the prefix begins some word, false otherwise.
+ *
+ *  @par Example
+ *  @verbatim
+
+	if ( !dictionary.has_prefix( word_str ) ) return;
+
+    @endverbatim
+************************************************************************/
+bool Dictionary::has_prefix( const string & prefix ) const {
+	return find( prefix ) != DICT_NO_NODE;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if a word is in the dictionary.
+ *
+ *  @param[in] word the word to look for.
+ *
+ *  @returns true if the word is in the dictionary, false otherwise.
+ *
+ *  @par Example
+ *  @verbatim
+
+	if ( word_len >= MIN_WORD_LEN && dictionary.contains( curr_sol ) )
+		found_words.emplace_back( curr_sol, coors );
+
+    @endverbatim
+************************************************************************/
+bool Dictionary::contains( const string & word ) const {
+	uint32_t node = find( word );
+	return node != DICT_NO_NODE && is_word( node );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the number of words in the dictionary.
+ *
+ *  @returns the number of words in the dictionary.
+************************************************************************/
+int Dictionary::size() const {
+	return word_count;
+}
+
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the node of the empty prefix, where every walk through the
+ *  dictionary starts.
+ *
+ *  @returns the index of the root node.
+************************************************************************/
+uint32_t Dictionary::root() const {
+	return 0;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Steps from a node to the node of the same prefix with one more letter
+ *  on the end. This lets a search carry its position in the dictionary
+ *  along instead of looking up the whole prefix every time.
+ *
+ *  @param[in] node the node of the current prefix.
+ *  @param[in] c the letter to add to the prefix.
+ *
+ *  @returns the node of the longer prefix or DICT_NO_NODE if no word
+ *  starts with it.
+ *
+ *  @par Example
+ *  @verbatim
+
+    uint32_t node = dictionary.root();
+	for( auto c : word ) {
+		node = dictionary.child( node, c );
+		if ( node == DICT_NO_NODE ) return false;
+	}
+	return dictionary.is_word( node );
+
+    @endverbatim
+************************************************************************/
+uint32_t Dictionary::child( uint32_t node, char c ) const {
+	if ( c < 'a' || c > 'z' ) return DICT_NO_NODE;
+	uint32_t bit = 1u << ( c - 'a' );
+	uint32_t mask = nodes[ node ].mask;
+	if ( !( mask & bit ) ) return DICT_NO_NODE;
+	return nodes[ node ].first + popcount( mask & ( bit - 1 ) );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if a word ends at a node.
+ *
+ *  @param[in] node the node to check.
+ *
+ *  @returns true if the prefix leading to the node is a whole word.
+************************************************************************/
+bool Dictionary::is_word( uint32_t node ) const {
+	return nodes[ node ].mask & DICT_TERMINAL;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the most letters that can be added after a node before a word
+ *  ends. A search that needs longer words than this can give up on the
+ *  node.
+ *
+ *  @param[in] node the node to check.
+ *
+ *  @returns the number of letters in the longest word starting with the
+ *  prefix of the node minus the length of the prefix. Nodes with 
+ *  DICT_HEIGHT_MAX letters or more return a number larger than any 
+ *  board.
+ *
+ *  @par Example
+ *  @verbatim
+
+	// skip the branch if no word is long enough
+	if ( int( search.word.size() ) + 1 + dictionary.longest_from( node ) < min_word_length ) 
+		return;
+
+    @endverbatim
+************************************************************************/
+int Dictionary::longest_from( uint32_t node ) const {
+	uint32_t height = nodes[ node ].mask >> DICT_HEIGHT_SHIFT;
+	if ( height == DICT_HEIGHT_MAX ) return numeric_limits<int>::max() / 2;
+	return static_cast<int>( height );
+}
@@ -10,8 +10,7 @@
  *  @author Adam Wood
  *
  *  @par Description
- *  Default constructor of PuzzleWord. sets the coordinate field to 
- *  nullptr.
+ *  Default constructor of PuzzleWord. The word covers no positions.
  *
  *  @par Example
  *  @verbatim
@@ -21,7 +20,8 @@
     @endverbatim
 ************************************************************************/
 PuzzleWord::PuzzleWord() {
-	coordinates = nullptr;
+	cells = 0;
+	edges = 0;
 }
 
 
@@ -29,13 +29,14 @@ PuzzleWord::PuzzleWord() {
  *  @author Adam Wood
  *
  *  @par Description
- *  Constructor that takes in a c++ string for the word and a 2d array
- *  for the coordinates of the word which gets copied into the coordinates
- *  field.
+ *  Constructor that takes in a c++ string for the word and the path the
+ *  word takes on the board. The path is copied and, on boards small 
+ *  enough, also turned into a bit mask of the positions it covers. The
+ *  edges of the board the path touches are noted too.
  *
  *  @param[in] w the word of the puzzle word
- *  @param[in] coor_original a 2d array marking the path that the word
- *  covers on the board. 
+ *  @param[in] p the position of each letter of the word in order, with
+ *  (x,y) stored as x + width * y.
  *
  *  @par Example
  *  @verbatim
@@ -45,60 +46,37 @@ PuzzleWord::PuzzleWord() {
 	// soap
 	// bomb
 
-	int coors[3][4] = {
-		{0,0,0,0},
-		{0,2,0,0},
-		{1,0,3,4}
-	};
+	vector<uint16_t> path = { 8, 5, 10, 11 };
 
-	PuzzleWord bomb1( "bomb", coors );
+	PuzzleWord bomb1( "bomb", path );
 
     @endverbatim
 ************************************************************************/
-PuzzleWord::PuzzleWord( string w, int ** coor_original ) {
+PuzzleWord::PuzzleWord( const string & w, const vector<uint16_t> & p ) {
 
 	word = w;
-
-	coordinates = alloc_2d_arr<int> ( width, height, 0 );
-	if( coordinates == nullptr ) {
-		std::cerr << "Failed to allocate memory\n";
-		exit ( 1 );
-		return;
+	path = p;
+
+	// a cell past the mask only happens when the board size is stale,
+	// and shifting by it would be undefined
+	cells = 0;
+	if ( bitboard() )
+		for( auto cell : path ) 
+			if ( cell < BITBOARD_MAX_CELLS )
+				cells |= uint64_t( 1 ) << cell;
+
+	// the board size isn't known until words are searched for
+	edges = 0;
+	for( size_t i = 0; i < path.size() && width > 0; i++ ) {
+		int cell = path[i];
+		int x = cell % width;
+		int y = cell / width;
+		if ( y == 0 ) edges |= EDGE_TOP;
+		if ( y == height - 1 ) edges |= EDGE_BOTTOM;
+		if ( x == 0 ) edges |= EDGE_LEFT;
+		if ( x == width - 1 ) edges |= EDGE_RIGHT;
 	}
 
-	// deep copy of coordinates
-	memcpy( coordinates[0], coor_original[0], width * height * sizeof( int ) );
-
-}
-
-
-/** **********************************************************************
- *  @author Adam Wood
- *
- *  @par Description
- *  Copy constructor for the PuzzleWord struct. Allows passing by value.
- *
- *  @param[in] other the puzzleword to copy.
- *
- *  @par Example
- *  @verbatim
-
-	int coors[3][4] = {
-		{0,0,0,0},
-		{0,2,0,0},
-		{1,0,3,4}
-	};
-
-    PuzzleWord bomb1( "bomb", coors );
-
-	PuzzleWord bomb2( bomb1 );
-
-    @endverbatim
-************************************************************************/
-PuzzleWord::PuzzleWord( PuzzleWord & other ) {
-	word = other.word;
-	coordinates = alloc_2d_arr<int> ( width, height, 0 );
-	memcpy( coordinates[0], other.coordinates[0], width * height * sizeof(int) );
 }
 
 
@@ -106,32 +84,13 @@ PuzzleWord::PuzzleWord( PuzzleWord & other ) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Moves the word and coordinate of a puzzle word into another word. The 
- *  moved puzzle word no longer contains the original data.
- *
- *  @param[in,out] other the puzzleword to move data from.
+ *  Checks whether the board is small enough for words to be tracked with
+ *  the cells bit mask.
  *
- *  @par Example
- *  @verbatim
-
-	int coors[3][4] = {
-		{0,0,0,0},
-		{0,2,0,0},
-		{1,0,3,4}
-	};
-
-    PuzzleWord temp( "bomb", coors );
-
-	PuzzleWord bomb;
-
-	bomb.move( temp );
-
-    @endverbatim
+ *  @returns true if the board has at most BITBOARD_MAX_CELLS positions.
 ************************************************************************/
-void PuzzleWord::move( PuzzleWord & other ) {
-	word.swap( other.word );
-	coordinates = other.coordinates;
-	other.coordinates = nullptr;
+bool PuzzleWord::bitboard() {
+	return width * height <= BITBOARD_MAX_CELLS;
 }
 
 
@@ -139,87 +98,75 @@ void PuzzleWord::move( PuzzleWord & other ) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Move constructor for the PuzzleWord struct.
- *
- *  @param[in,out] other the puzzleword to move data to.
-************************************************************************/
-PuzzleWord::PuzzleWord( PuzzleWord && other ) {
-	move( other );
-}
-
-
-/** **********************************************************************
- *  @author Adam Wood
+ *  Checks if the locations of two words on a NYT Strands board overlap
+ *  at all. On boards of up to BITBOARD_MAX_CELLS positions this is a 
+ *  single and of the two masks.
  *
- *  @par Description
- *  Swaps the word and coordinates field between two PuzzleWord structs.
+ *  @param[in] other the puzzle word to check for overlap with
  *
- *  @param[in,out] a the first PuzzleWord.
- *  @param[in,out] b the second PuzzleWord.
+ *  @returns true if the words overlap, false if not
  *
  *  @par Example
  *  @verbatim
 
-	int coors[3][4] = {
-		{0,0,0,0},
-		{0,2,0,0},
-		{1,0,3,4}
-	};
-
-	int coors2[3][4] = {
-		{0,0,0,0},
-		{0,0,0,0},
-		{1,2,3,4}
-	};
-
-    PuzzleWord bomb1( "bomb", coors );
-
-	PuzzleWord bomb2( "bomb", coors2 );
+    // check if word overlaps with words in our working solution
+	// if so it cannot be part of the solution
+	bool overlapping = false;
+	
+	for( auto idx : indicies ) {
+		if( found_words[i].overlap( found_words[ idx ] ) ) {
+			overlapping = true;
+			break;
+		}
+	}
+	
 
-	swap( bomb1, bomb2 );
+	if( overlapping ) continue;
 
     @endverbatim
 ************************************************************************/
-void swap( PuzzleWord & a, PuzzleWord & b ) {
-	a.word.swap( b.word );
-	swap( a.coordinates, b.coordinates );
+bool PuzzleWord::overlap( const PuzzleWord & other ) const {
+	if ( bitboard() ) return ( cells & other.cells ) != 0;
+	for ( auto cell : path )
+		if ( find( other.path.begin(), other.path.end(), cell ) != other.path.end() ) 
+			return true;
+	return false;
 }
 
 
-
 /** **********************************************************************
  *  @author Adam Wood
  *
  *  @par Description
- *  Copy assignment for the PuzzleWord class.
+ *  Checks if two puzzle words cover the exact same positions, in any 
+ *  order. On boards of up to BITBOARD_MAX_CELLS positions this is a 
+ *  single compare of the two masks.
  *
- *  @param[in] other the puzzleword to assign from.
+ *  @param[in] other the puzzle word to compare with.
  *
- *  @returns a reference to the copied puzzle word.
+ *  @returns true if the puzzle words cover the same positions, false
+ *  if not.
  *
  *  @par Example
  *  @verbatim
 
-    int coors[3][4] = {
-		{0,0,0,0},
-		{0,2,0,0},
-		{1,0,3,4}
-	};
-
-    PuzzleWord bomb1( "bomb", coors );
-
-	PuzzleWord bomb2 = bomb1;
+	// ensure we don't find two of the same word in the same places
+	for( auto & pw : found_words ) {
+		if( pw.word == candidate.word && pw.same_cells( candidate ) ) {
+			overlap = true;
+			break;
+		}
+	}
 
     @endverbatim
 ************************************************************************/
-PuzzleWord& PuzzleWord::operator=(PuzzleWord& other) {
-	// only perform the operation if the two structs are different
-	if( this != &other ) {
-		// create use the copy constructor then swap the temporary
-		PuzzleWord temp( other );
-		swap( *this, temp );
-	}
-	return *this;
+bool PuzzleWord::same_cells( const PuzzleWord & other ) const {
+	if ( bitboard() ) return cells == other.cells;
+	if ( path.size() != other.path.size() ) return false;
+	for ( auto cell : path )
+		if ( find( other.path.begin(), other.path.end(), cell ) == other.path.end() ) 
+			return false;
+	return true;
 }
 
 
@@ -227,27 +174,17 @@ PuzzleWord& PuzzleWord::operator=(PuzzleWord& other) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Move assignment for the PuzzleWord class.
- *
- *  @param[in,out] other the puzzleword to assign from.
+ *  Checks if the word covers a position on the board.
  *
- *  @returns a reference to the puzzle word the data moved to.
-************************************************************************/
-PuzzleWord& PuzzleWord::operator=(PuzzleWord&& other) {
-	if( this != &other )
-		move( other );
-	return *this;
-}
-
-
-/** **********************************************************************
- *  @author Adam Wood
+ *  @param[in] x the x position of the board to check.
+ *  @param[in] y the y position of the board to check.
  *
- *  @par Description
- *  Deconstructor for the PuzzleWord struct. Frees up the coordinates field.
+ *  @returns true if one of the letters of the word is at (x,y).
 ************************************************************************/
-PuzzleWord::~PuzzleWord() {
-	free_2d( coordinates );
+bool PuzzleWord::covers( int x, int y ) const {
+	int cell = x + width * y;
+	if ( bitboard() ) return ( cells >> cell ) & 1;
+	return find( path.begin(), path.end(), cell ) != path.end();
 }
 
 
@@ -255,42 +192,22 @@ PuzzleWord::~PuzzleWord() {
  *  @author Adam Wood
  *
  *  @par Description
- *  Checks if the locations of two words on a NYT Strands board overlap
- *  at all.
+ *  Checks if the word could be the spangram of the puzzle, which touches
+ *  two opposite edges of the board.
  *
- *  @param[in] other the puzzle word to check for overlap with
- *
- *  @returns true if the words overlap, false if not
+ *  @returns true if the word touches the top and bottom or the left and
+ *  right edges of the board.
  *
  *  @par Example
  *  @verbatim
 
-    // check if word overlaps with words in our working solution
-	// if so it cannot be part of the solution
-	bool overlapping = false;
-	
-	for( auto idx : indicies ) {
-		if( found_words[i].overlap( found_words[ idx ] ) ) {
-			overlapping = true;
-			break;
-		}
-	}
-	
-
-	if( overlapping ) continue;
+	if( found_words[i].spangram() ) spangrams.push_back( i );
 
     @endverbatim
 ************************************************************************/
-bool PuzzleWord::overlap( PuzzleWord & other ) {
-	for ( int y = 0; y < height; y++ ) {
-		for ( int x = 0; x < width; x++ ) {
-			int c1 = coordinates[y][x];
-			int c2 = other.coordinates[y][x];
-			// if both coordinates are non-zero there is an overlap
-			if ( c1 != 0 && c2 != 0 ) return true;
-		}
-	}
-	return false;
+bool PuzzleWord::spangram() const {
+	return ( ( edges & EDGE_TOP ) && ( edges & EDGE_BOTTOM ) ) 
+		|| ( ( edges & EDGE_LEFT ) && ( edges & EDGE_RIGHT ) );
 }
 
 
@@ -298,15 +215,15 @@ bool PuzzleWord::overlap( PuzzleWord & other ) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Checks if two puzzle words share the exact same letters on the exact
- *  same positions.
+ *  Checks if a puzzle word covers exactly the positions marked in a
+ *  2d array.
  *
  *  @param[in] coors 2d array which marks which letters on the board are used
- *  on another puzzle word. Can either be a 2d array of ints like the coordinates
- *  field or a boolean array.
+ *  on another puzzle word. Can either be a 2d array of ints or a boolean 
+ *  array.
  *
- *  @returns true if the puzzle words share the exact same locations, false
- *  if not.
+ *  @returns true if the puzzle word covers exactly the marked positions, 
+ *  false if not.
  *
  *  @par Example
  *  @verbatim
@@ -331,16 +248,17 @@ bool PuzzleWord::overlap( PuzzleWord & other ) {
 ************************************************************************/
 template <typename T>
 bool PuzzleWord::total_overlap ( T ** coors ) {
+	size_t marked = 0;
 	for ( int y = 0; y < height; y++ ) {
 		for ( int x = 0; x < width; x++ ) {
-			int c1 = coordinates[y][x] ? 1 : 0;
-			int c2 = coors[y][x] ? 1 : 0;
-			// every coordinate must match
+			if ( !coors[y][x] ) continue;
+			// every marked coordinate must be in the word
 			// otherwise return false
-			if ( c1 != c2 ) return false;
+			if ( !covers( x, y ) ) return false;
+			marked++;
 		}
 	}
-	return true;
+	return marked == path.size();
 }
 
 template bool PuzzleWord::total_overlap<int>( int ** coors ); 
@@ -435,7 +353,9 @@ char * PuzzleWord::get_word() {
  *  0 if that position is not in the word.
 ************************************************************************/
 int PuzzleWord::get_coordinate( int x, int y ) {
-	return coordinates[y][x];
+	if ( !covers( x, y ) ) return 0;
+	int cell = x + width * y;
+	return static_cast<int>( find( path.begin(), path.end(), cell ) - path.begin() ) + 1;
 }
 
 
@@ -463,7 +383,7 @@ void PuzzleWord::print_coors ( ostream & out ) {
 	out << right;
 	for( int y = 0; y < height; y++ ) {
 		for( int x = 0; x < width; x++ ) {
-			out << setw(3) << coordinates[y][x];
+			out << setw(3) << get_coordinate( x, y );
 		}
 		out << "\n";
 	}
@@ -18,105 +18,275 @@
  *  and does all of the actual work recursively. The public equivalient
  *  of this function is StrandsBoard::find_all_words.
  *
- *  @param[in, out] word_str the c string representing the current working
- *  word.
- *  @param[in, out] coors a 2d array of integers representing which spots
- *  on the board have been visited and in what order.
- *  @param[in, out] already_found keeps track of what words have been found
- *  on the board so far.
- *  @param[in] x the current x position of the working word on the board.
- *  @param[in] y the current y position of the working word on the board.
- *  @param[in] word_len the current length of the working word.
+ *  @param[in, out] search the working word, the positions it covers and
+ *  the words found so far.
+ *  @param[in] cell the linearized position of the next letter of the
+ *  working word. It must not be used on the board or by the working word.
+ *  @param[in] node the dictionary node of the working word, which is
+ *  carried along so each step is a single lookup.
  *
  *
  *  @par Example
  *  @verbatim
 
-    set<string> already_found;
+    WordSearch<Cells> search;
+	search.path_cells = no_cells<Cells>( size() );
+	search.blocked = no_cells<Cells>( size() );
 
-	// allocate array to keep track of used spots on the board
-	int ** coors = alloc_2d_arr<int>( width, height, 0 );
-	if( coors == nullptr ) exit( 1 );
-
-	// allocate c string for individual solutions
-	char * word_str = new (nothrow) char [ size() + 1 ];
-	if ( word_str == nullptr ) exit( 1 );
-	for( int i = 0; i <= size(); i++ )
-		word_str[i] = '\0';
-
-	// get all words starting from each place on the board
-	for( int y = 0; y < height; y++ )
-		for ( int x = 0; x < width; x++ )
-			find_all_words_from_point( word_str, coors, already_found, x, y, 0 );
+	// get all words starting from each unused place on the board
+	for( int cell = 0; cell < size(); cell++ )
+		if ( !test_cell( search.blocked, cell ) )
+			find_all_words_from_point( search, cell, search_dictionary->root() );
 
     @endverbatim
 ************************************************************************/
+template <typename Cells>
 void StrandsBoard::find_all_words_from_point ( 
-	char * word_str, 
-	int ** coors, 
-	set<string> & already_found, 
-	int x, 
-	int y, 
-	int word_len 
+	WordSearch<Cells> & search,
+	int cell, 
+	uint32_t node
 ) {
 
-	// if we are out of bounds or if the word is not a prefix of any known word,
-	// or if the position is already in use in our working word,
-	// we return from the function
-	if ( !in_bounds( x, y ) || used[y][x] 
-	|| !prefix_tree.contains( word_str ) ) return;
+	int y = cell / width;
+	int x = cell % width;
 
-	word_str[ word_len ] = board[y][x];
-	word_len++;
-	coors[y][x] = word_len;
-	used[y][x] = true;
+	// step the working word's node along by this letter. if the longer
+	// word is not a prefix of any known word we return from the function
+	node = search_dictionary->child( node, board[y][x] );
+	if ( node == DICT_NO_NODE ) return;
+
+	// and return if no word starting this way can be kept
+	if ( !worth_following( search, cell, node, int( search.word.size() ) + 1 ) ) return;
+
+	search.word.push_back( board[y][x] );
+	search.path.push_back( static_cast<uint16_t>( cell ) );
+	set_cell( search.path_cells, cell );
 
 	// insert a found word if it is a solution
-	string curr_sol = string( word_str );
-	if ( word_len >= MIN_WORD_LEN && dictionary.contains( curr_sol ) ) {
+	if ( static_cast<int>( search.word.size() ) >= min_word_length && search_dictionary->is_word( node ) 
+	&& ( search.through < 0 || test_cell( search.path_cells, search.through ) ) )
+		search.add_found_word( search.word, search.path, search.path_cells );
 
+	// only continue onto neighbors that aren't already in use in our
+	// working word or on the board
+	for( int * next = neighbors[cell]; *next != -1 && !search.stopped; next++ )
+		if ( !test_cell( search.blocked, *next ) && !test_cell( search.path_cells, *next ) )
+			find_all_words_from_point( search, *next, node );
 
-		int overlap = false;
+	// mark the node as unvisited
+	search.word.pop_back();
+	search.path.pop_back();
+	reset_cell( search.path_cells, cell );
 
-		// ensure we don't find two of the same word with the same letters in the same places
-		// however, it is fine if we find two of the same word but they share different shapes on the board
-		if( already_found.contains( curr_sol ) ) {
-			for( auto & pw : found_words ) {
-				if( pw.word == curr_sol && pw.total_overlap( coors ) ) {
-					overlap = true;
-					break;
-				}
-			}
-		}
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks if the working word of a search, after adding the letter at a
+ *  position, could still grow into a word the search keeps. The word has
+ *  to be able to reach min_word_length letters, and if the search only
+ *  keeps words through a certain letter, it has to be able to reach that
+ *  letter, which is at least as many letters away as king moves.
+ *
+ *  @param[in] search the search the working word belongs to.
+ *  @param[in] cell the linearized position of the added letter.
+ *  @param[in] node the dictionary node of the working word with the
+ *  letter added.
+ *  @param[in] length the length of the working word with the letter
+ *  added.
+ *
+ *  @returns false if the search can skip everything after the letter.
+************************************************************************/
+template <typename Cells>
+bool StrandsBoard::worth_following( 
+	const WordSearch<Cells> & search, 
+	int cell, 
+	uint32_t node, 
+	int length 
+) {
 
-		if( !overlap ) {
+	int longest = search_dictionary->longest_from( node );
+	if ( length + longest < min_word_length ) return false;
 
-			found_words.emplace_back( curr_sol, coors );
-			already_found.insert( curr_sol );
+	if ( search.through < 0 || cell == search.through || test_cell( search.path_cells, search.through ) ) 
+		return true;
 
+	int distance = max( 
+		abs( cell % width - search.through % width ), 
+		abs( cell / width - search.through / width ) 
+	);
+	return distance <= longest;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds the same words as StrandsBoard::find_all_words_from_point, in
+ *  the same order, but walks the board with a loop over an explicit
+ *  stack of frames instead of recursing. The stack never holds more
+ *  frames than there are letters on the board, so it is sized once and
+ *  the longest possible word does not depend on the size of the call 
+ *  stack, which is small in the web build.
+ *
+ *  @param[in, out] search the working word, the positions it covers and
+ *  the words found so far.
+ *  @param[in] start the linearized position of the first letter. It 
+ *  must not be used on the board.
+ *
+ *  @par Example
+ *  @verbatim
+
+	for( int cell = 0; cell < size(); cell++ )
+		if ( !test_cell( search.blocked, cell ) )
+			find_all_words_iterative( search, cell );
+
+    @endverbatim
+************************************************************************/
+template <typename Cells>
+void StrandsBoard::find_all_words_iterative( WordSearch<Cells> & search, int start ) {
+
+	search.frames.resize( size() );
+	SearchFrame * frames = search.frames.data();
+	int depth = -1;
+
+	// adds a letter to the working word, returning false if no word that
+	// can be kept starts with the longer working word
+	auto push = [&]( int cell, uint32_t node ) {
+
+		char letter = board[ cell / width ][ cell % width ];
+		node = search_dictionary->child( node, letter );
+		if ( node == DICT_NO_NODE ) return false;
+		if ( !worth_following( search, cell, node, depth + 2 ) ) return false;
+
+		search.word.push_back( letter );
+		search.path.push_back( static_cast<uint16_t>( cell ) );
+		set_cell( search.path_cells, cell );
+		frames[ ++depth ] = { cell, node, neighbors[cell] };
+
+		// insert a found word if it is a solution
+		if ( depth + 1 >= min_word_length && search_dictionary->is_word( node ) 
+		&& ( search.through < 0 || test_cell( search.path_cells, search.through ) ) )
+			search.add_found_word( search.word, search.path, search.path_cells );
+
+		return true;
+
+	};
+
+	push( start, search_dictionary->root() );
+
+	while ( depth >= 0 && !search.stopped ) {
+
+		SearchFrame & frame = frames[depth];
+
+		// move on to the next neighbor that isn't already in use in our
+		// working word or on the board
+		int next = *frame.next;
+		while ( next != -1 && ( test_cell( search.blocked, next ) || test_cell( search.path_cells, next ) ) )
+			next = *++frame.next;
+
+		if ( next != -1 ) {
+			frame.next++;
+			push( next, frame.node );
+			continue;
 		}
 
+		// every neighbor is done so mark the letter as unvisited
+		search.word.pop_back();
+		search.path.pop_back();
+		reset_cell( search.path_cells, frame.cell );
+		depth--;
+
 	}
 
-	int moves[][2] = {
-		{ 1, 0 },
-		{ -1, 0 },
-		{ 0, 1 },
-		{ 0, -1 },
-		{ 1, 1 },
-		{ 1, -1 },
-		{ -1, 1 },
-		{ -1, -1 }
+	// if the visitor stopped the search, unwind the working word
+	for( ; depth >= 0; depth-- )
+		reset_cell( search.path_cells, frames[depth].cell );
+	search.word.clear();
+	search.path.clear();
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Does the work of StrandsBoard::visit_words using Cells as the
+ *  type for sets of positions on the board.
+************************************************************************/
+template <typename Cells>
+void StrandsBoard::find_all_words_with( const WordVisitor & visitor, bool skip_used, int through ) { 
+
+	// letters marked as used can't be part of any word
+	Cells blocked = no_cells<Cells>( size() );
+	for( int y = 0; y < height && skip_used; y++ )
+		for ( int x = 0; x < width; x++ )
+			if ( used[y][x] ) set_cell( blocked, linearize_coor( x, y ) );
+
+	auto start_search = [&]( WordSearch<Cells> & search ) {
+		search.word.reserve( size() );
+		search.path.reserve( size() );
+		search.path_cells = no_cells<Cells>( size() );
+		search.blocked = blocked;
+		search.through = through;
+	};
+
+	auto search_from = [&]( WordSearch<Cells> & search, int cell ) {
+		if ( search_engine == SEARCH_ITERATIVE )
+			find_all_words_iterative( search, cell );
+		else
+			find_all_words_from_point( search, cell, search_dictionary->root() );
 	};
 
-	for( auto move : moves )
-		find_all_words_from_point( word_str, coors, already_found, x + move[0], y + move[1], word_len );
+	int threads = search_threads > 0 ? search_threads : int( thread::hardware_concurrency() );
 
-	// mark the node as unvisited
-	word_len--;
-	word_str[ word_len ] = '\0';
-	used[y][x] = false;
-	coors[y][x] = 0;
+	if ( threads <= 1 ) {
+
+		WordSearch<Cells> search;
+		start_search( search );
+		search.visitor = &visitor;
+
+		// get all words starting from each unused place on the board
+		for( int cell = 0; cell < size() && !search.stopped; cell++ )
+			if ( !test_cell( blocked, cell ) )
+				search_from( search, cell );
+
+		return;
+
+	}
+
+	// each start position gets its own search, and each thread takes the
+	// next start position nobody has taken yet until there are none left
+	vector<WordSearch<Cells>> searches( size() );
+	atomic<int> next_cell( 0 );
+
+	auto worker = [&]() {
+		for( int cell = next_cell++; cell < size(); cell = next_cell++ ) {
+			if ( test_cell( blocked, cell ) ) continue;
+			start_search( searches[cell] );
+			search_from( searches[cell], cell );
+		}
+	};
+
+	vector<thread> pool;
+	for( int i = 1; i < min( threads, size() ); i++ )
+		pool.emplace_back( worker );
+	worker();
+	for( auto & t : pool )
+		t.join();
+
+	// merge in order of start position so the visitor sees the words
+	// exactly as it would from a single search
+	WordSearch<Cells> merged;
+	merged.visitor = &visitor;
+	for( auto & search : searches )
+		for( size_t i = 0; i < search.found_words.size() && !merged.stopped; i++ )
+			merged.add_found_word( search.found_words[i].word, search.found_words[i].path, search.found_cells[i] );
 
 }
 
@@ -130,9 +300,12 @@ void StrandsBoard::find_all_words_from_point (
  *  board by recursively
  *  finding every valid path on the board and checks if the path corresponds
  *  to a valid english word. If so, the word is added to the found_words
- *  vector. This function is a public function that calls
- *  StrandsBoard::find_all_words_from_point to do all of the work.
- *  The list of words is then sorted in order of decreasing length.
+ *  vector. The list of words is in order of decreasing length.
+ *
+ *  The board is only searched again when its text changes. Every word
+ *  is kept in an index by the positions it covers, so after letters are
+ *  marked as used or unused the words are just taken from the index,
+ *  leaving out the ones covering used letters.
  *
  *  @par Example
  *  @verbatim
@@ -161,33 +334,563 @@ void StrandsBoard::find_all_words() {
 	PuzzleWord::height = height;
 	PuzzleWord::width = width;
 
-	set<string> already_found;
+	index_all_words();
+	update_used_index();
 
-	// allocate array to keep track of used spots on the board
-	int ** coors = alloc_2d_arr<int>( width, height, 0 );
-	if( coors == nullptr ) exit( 1 );
+	// keep the words with no used letters, which are already sorted
+	for( size_t i = 0; i < all_words.size(); i++ )
+		if ( used_in_word[i] == 0 )
+			found_words.push_back( all_words[i] );
 
-	// allocate c string for individual solutions
-	char * word_str = new (nothrow) char [ size() + 1 ];
-	if ( word_str == nullptr ) exit( 1 );
-	for( int i = 0; i <= size(); i++ )
-		word_str[i] = '\0';
+	index_found_words();
 
-	// get all words starting from each place on the board
-	for( int y = 0; y < height; y++ )
-		for ( int x = 0; x < width; x++ )
-			find_all_words_from_point( word_str, coors, already_found, x, y, 0 );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Builds found_cell_words for the current found_words, so the words 
+ *  covering a position can be looked up without checking every word.
+************************************************************************/
+void StrandsBoard::index_found_words() {
+
+	found_cell_words.assign( size(), vector<int>() );
+	for( size_t i = 0; i < found_words.size(); i++ )
+		for( auto cell : found_words[i].path )
+			found_cell_words[ cell ].push_back( static_cast<int>( i ) );
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds every word on the board as if no letters were used and indexes
+ *  them by the positions they cover, unless that was already done for
+ *  the current text of the board. Afterwards, marking letters as used
+ *  or unused only has to look at the words covering those letters 
+ *  instead of searching the board again.
+************************************************************************/
+void StrandsBoard::index_all_words() {
+
+	string text = board_text();
+	if ( text == all_words_text ) return;
+
+	all_words.clear();
+	min_word_length = MIN_WORD_LEN;
+
+	visit_words( [this]( const string & word, const vector<uint16_t> & path ) {
+		all_words.emplace_back( word, path );
+		return true;
+	}, false );
+
+	// no letters are counted as used yet
+	indexed_used.assign( size(), false );
+	index_words_by_cell();
+	all_words_text = std::move( text );
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Sorts all_words and builds cell_words and used_in_word for it, with
+ *  the letters in indexed_used counted as used.
+************************************************************************/
+void StrandsBoard::index_words_by_cell() {
+
+	// sort the found words by length
+	sort( all_words.begin(), all_words.end() );
+
+	cell_words.assign( size(), vector<int>() );
+	used_in_word.assign( all_words.size(), 0 );
+	for( size_t i = 0; i < all_words.size(); i++ ) {
+		for( auto cell : all_words[i].path ) {
+			cell_words[ cell ].push_back( static_cast<int>( i ) );
+			used_in_word[i] += indexed_used[ cell ];
+		}
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Changes one letter of the board. If every word on the board was
+ *  already found for the old text, only the words through the changed
+ *  letter are dropped and only the words through the new letter are
+ *  searched for, so the next StrandsBoard::find_all_words doesn't have
+ *  to search the whole board. Typing a board in one letter at a time
+ *  stays quick this way.
+ *
+ *  @param[in] x the x position of the letter.
+ *  @param[in] y the y position of the letter.
+ *  @param[in] letter the new letter.
+ *
+ *  @par Example
+ *  @verbatim
+
+	board.find_all_words();
+
+	// fix a typo
+	board.set_letter( 2, 5, 'q' );
+	board.find_all_words();
+
+    @endverbatim
+************************************************************************/
+void StrandsBoard::set_letter( int x, int y, char letter ) {
+
+	if ( !in_bounds( x, y ) || board[y][x] == letter ) return;
+
+	bool indexed = !all_words_text.empty() && board_text() == all_words_text;
+	if ( !indexed ) {
+		board[y][x] = letter;
+		return;
+	}
+
+	replace_letter( x, y, letter );
+	index_words_by_cell();
+	all_words_text = board_text();
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Changes one letter of a board whose words are all in all_words. The
+ *  words through the letter are dropped and the words through the new
+ *  letter are searched for and appended, but the words aren't indexed
+ *  again, so several letters can be changed before one call to
+ *  StrandsBoard::index_words_by_cell.
+ *
+ *  @param[in] x the x position of the letter.
+ *  @param[in] y the y position of the letter.
+ *  @param[in] letter the new letter.
+************************************************************************/
+void StrandsBoard::replace_letter( int x, int y, char letter ) {
+
+	board[y][x] = letter;
+	int cell = linearize_coor( x, y );
+
+	// keep the words that don't go through the letter
+	vector<PuzzleWord> kept;
+	kept.reserve( all_words.size() );
+	for( auto & puzzle_word : all_words )
+		if ( find( puzzle_word.path.begin(), puzzle_word.path.end(), cell ) == puzzle_word.path.end() )
+			kept.push_back( std::move( puzzle_word ) );
+	all_words = std::move( kept );
+
+	min_word_length = MIN_WORD_LEN;
+	visit_words( [this]( const string & word, const vector<uint16_t> & path ) {
+		all_words.emplace_back( word, path );
+		return true;
+	}, false, cell );
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Brings used_in_word up to date with the used member. Only letters 
+ *  whose used value changed since the last update are looked at, and 
+ *  for each of those only the words covering it.
+************************************************************************/
+void StrandsBoard::update_used_index() {
+
+	for( int cell = 0; cell < size(); cell++ ) {
+
+		bool now_used = used[ cell / width ][ cell % width ];
+		if ( now_used == indexed_used[ cell ] ) continue;
+
+		int change = now_used ? 1 : -1;
+		for( auto index : cell_words[ cell ] )
+			used_in_word[ index ] += change;
+		indexed_used[ cell ] = now_used;
+
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Fills found_words with only the longest words on the board, sorted
+ *  in order of decreasing length like StrandsBoard::find_all_words.
+ *  The words kept so far sit in a heap with the shortest on top. Once
+ *  the heap is full, the search skips every branch of the dictionary 
+ *  that can't make a word longer than the shortest one kept, which on
+ *  most boards is nearly all of them. Among words of the same length
+ *  the ones found first are kept.
+ *
+ *  @param[in] amount how many words to keep. 0 keeps every word of at
+ *  least min_length letters.
+ *  @param[in] min_length the fewest letters a word can have.
+ *
+ *  @par Example
+ *  @verbatim
+
+	// the 20 longest words
+	board.find_longest_words( 20 );
+
+	// every word with at least 8 letters
+	board.find_longest_words( 0, 8 );
+
+    @endverbatim
+************************************************************************/
+void StrandsBoard::find_longest_words( int amount, int min_length ) {
+
+	found_words.clear();
+	min_word_length = max( min_length, MIN_WORD_LEN );
+
+	// each word is kept with the order it was found in. the heap puts the
+	// word that would be dropped first on top
+	vector<pair<size_t, PuzzleWord>> heap;
+	auto better = []( const pair<size_t, PuzzleWord> & a, const pair<size_t, PuzzleWord> & b ) {
+		if ( a.second.word.size() != b.second.word.size() )
+			return a.second.word.size() > b.second.word.size();
+		return a.first < b.first;
+	};
+
+	size_t found = 0;
+	visit_all_words( [&]( const string & word, const vector<uint16_t> & path ) {
+
+		// words found before the heap filled up may be too short now
+		if ( static_cast<int>( word.size() ) < min_word_length ) return true;
+
+		heap.emplace_back( found++, PuzzleWord( word, path ) );
+		push_heap( heap.begin(), heap.end(), better );
+
+		if ( amount <= 0 || static_cast<int>( heap.size() ) < amount ) return true;
+
+		if ( static_cast<int>( heap.size() ) > amount ) {
+			pop_heap( heap.begin(), heap.end(), better );
+			heap.pop_back();
+		}
+
+		// from now on only words longer than the shortest kept one matter
+		min_word_length = static_cast<int>( heap.front().second.word.size() ) + 1;
+		return true;
+
+	} );
+
+	min_word_length = MIN_WORD_LEN;
+
+	for( auto & kept : heap )
+		found_words.push_back( std::move( kept.second ) );
 
 	// sort the found words by length
 	sort( found_words.begin(), found_words.end() );
 
-	// free up dynamically allocated memory
-	delete [] word_str;
-	free_2d<int>( coors );
+	index_found_words();
 
 }
 
 
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds all english words of at least 4 letters on the board that don't
+ *  use any used letters, calling a visitor with each word and its path
+ *  as soon as it is found instead of storing them. Words come in the 
+ *  order they are found, not sorted, and each word covering the same
+ *  positions is only visited once. The visitor can return false to stop
+ *  the search early.
+ *
+ *  With more than one search thread the words are only visited once
+ *  every thread has finished, in the same order as a single thread.
+ *
+ *  @param[in] visitor called with each word and the linearized positions
+ *  of its letters.
+ *
+ *  @par Example
+ *  @verbatim
+
+	// print the first ten words with at least 8 letters
+	int printed = 0;
+	board.visit_all_words( [&]( const string & word, const vector<uint16_t> & path ) {
+		if ( word.size() >= 8 ) {
+			cout << word << endl;
+			printed++;
+		}
+		return printed < 10;
+	} );
+
+    @endverbatim
+************************************************************************/
+void StrandsBoard::visit_all_words( const WordVisitor & visitor ) { 
+	visit_words( visitor, true );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Does the work of StrandsBoard::visit_all_words, optionally treating
+ *  every letter as unused or only visiting words through one letter.
+ *
+ *  @param[in] visitor called with each word and the linearized positions
+ *  of its letters.
+ *  @param[in] skip_used whether words may not use letters marked as used.
+ *  @param[in] through the linearized position every word has to cover,
+ *  or -1 for every word. Words through a letter are looked up in the
+ *  shared dictionary, since the letter was most likely just edited and
+ *  board_dictionary would have to be made again.
+************************************************************************/
+void StrandsBoard::visit_words( const WordVisitor & visitor, bool skip_used, int through ) { 
+
+	PuzzleWord::height = height;
+	PuzzleWord::width = width;
+
+	if ( through < 0 ) {
+		fit_dictionary();
+		search_dictionary = board_dictionary.get();
+	} else 
+		search_dictionary = &dictionary;
+
+	// use the smallest set of positions that fits the board
+	switch ( cell_engine ) {
+		case CELLS_64:
+			find_all_words_with<uint64_t>( visitor, skip_used, through );
+			break;
+		case CELLS_128:
+			find_all_words_with<cells128_t>( visitor, skip_used, through );
+			break;
+		default:
+			find_all_words_with<DynamicCells>( visitor, skip_used, through );
+			break;
+	}
+
+}
+
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Creates a budget with the limits of a set of solve options. The clock
+ *  for the time limit starts now.
+ *
+ *  @param[in] options the limits on the search.
+ *
+ *  @par Example
+ *  @verbatim
+
+	SolveBudget budget( solve_options );
+
+    @endverbatim
+************************************************************************/
+SolveBudget::SolveBudget( const SolveOptions & options ) : 
+	calls( 0 ), 
+	solutions( 0 ),
+	max_calls( options.max_calls > 0 ? options.max_calls : numeric_limits<int>::max() ),
+	max_solutions( options.max_solutions > 0 ? options.max_solutions : numeric_limits<int>::max() ),
+	has_deadline( options.max_ms > 0 ),
+	deadline( chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>( 
+		chrono::duration<double, milli>( max( options.max_ms, 0.0 ) ) ) ),
+	stop_reason( SOLVE_COMPLETE ) {}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Counts one recursive call against the budget, stopping the search 
+ *  once there are none left. The clock is only read every 
+ *  SOLVE_CLOCK_CALLS calls since reading it costs more than a call.
+ *
+ *  @par Example
+ *  @verbatim
+
+	budget.spend();
+	find_solution_from_words_rec( ... );
+
+    @endverbatim
+************************************************************************/
+void SolveBudget::spend() {
+
+	int made = calls.fetch_add( 1, memory_order_relaxed ) + 1;
+
+	if ( made >= max_calls ) 
+		stop( SOLVE_OUT_OF_CALLS );
+	else if ( has_deadline && made % SOLVE_CLOCK_CALLS == 0 && chrono::steady_clock::now() >= deadline )
+		stop( SOLVE_OUT_OF_TIME );
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Counts one solution found, stopping the search once there are enough.
+ *
+ *  @par Example
+ *  @verbatim
+
+	solutions.push_back( chosen );
+	budget.add_solution();
+
+    @endverbatim
+************************************************************************/
+void SolveBudget::add_solution() {
+	if ( solutions.fetch_add( 1, memory_order_relaxed ) + 1 >= max_solutions )
+		stop( SOLVE_ENOUGH_SOLUTIONS );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Stops the search on every thread. Only the first reason given is kept.
+ *
+ *  @param[in] reason why the search stopped.
+ *
+ *  @par Example
+ *  @verbatim
+
+	budget.stop( SOLVE_OUT_OF_TIME );
+
+    @endverbatim
+************************************************************************/
+void SolveBudget::stop( SolveStop reason ) {
+	SolveStop running = SOLVE_COMPLETE;
+	stop_reason.compare_exchange_strong( running, reason, memory_order_relaxed );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Checks whether the search should stop.
+ *
+ *  @returns true once any limit has been reached.
+ *
+ *  @par Example
+ *  @verbatim
+
+	if( budget.spent() ) return;
+
+    @endverbatim
+************************************************************************/
+bool SolveBudget::spent() const {
+	return stop_reason.load( memory_order_relaxed ) != SOLVE_COMPLETE;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds the uncovered letter with the fewest found words that could
+ *  still cover it without overlapping the working solution. One of
+ *  those words has to be in any solution, so the solver only tries them.
+ *
+ *  @param[in] word_cells the positions covered by each found word.
+ *  @param[in] covered the positions covered by the working solution.
+ *
+ *  @returns the linearized position of the letter, or -1 if some letter
+ *  can't be covered by any word.
+ *
+ *  @par Example
+ *  @verbatim
+
+	int best_cell = most_constrained_cell( word_cells, covered );
+	if( best_cell == -1 ) return;
+
+    @endverbatim
+************************************************************************/
+template <typename Cells>
+int StrandsBoard::most_constrained_cell( const vector<Cells> & word_cells, const Cells & covered ) {
+
+	int best_cell = -1;
+	int best_count = numeric_limits<int>::max();
+	for( int cell = 0; cell < size(); cell++ ) {
+
+		if( test_cell( covered, cell ) ) continue;
+
+		// stop counting once the letter can't beat the best one
+		int count = 0;
+		for( auto i : found_cell_words[ cell ] )
+			if( !cells_intersect( word_cells[i], covered ) && ++count >= best_count ) break;
+
+		if( count == 0 ) return -1;
+
+		if( count < best_count ) {
+			best_count = count;
+			best_cell = cell;
+		}
+
+	}
+
+	return best_cell;
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Flood fills the uncovered letters connected to a starting letter
+ *  through the neighbor table.
+ *
+ *  @param[in] covered the positions that are already covered.
+ *  @param[in] start the linearized position to start from.
+ *  @param[in, out] region the positions reached are added to this.
+ *
+ *  @returns the number of positions reached.
+ *
+ *  @par Example
+ *  @verbatim
+
+	Cells region = no_cells<Cells>( size() );
+	int region_size = fill_region( covered, start, region );
+
+    @endverbatim
+************************************************************************/
+template <typename Cells>
+int StrandsBoard::fill_region( const Cells & covered, int start, Cells & region ) {
+
+	// the fill never recurses so each thread can keep reusing one stack
+	static thread_local vector<int> stack;
+
+	int region_size = 0;
+	set_cell( region, start );
+	stack.push_back( start );
+
+	while( !stack.empty() ) {
+		int cell = stack.back();
+		stack.pop_back();
+		region_size++;
+		for( int * next = neighbors[cell]; *next != -1; next++ ) {
+			if( test_cell( covered, *next ) || test_cell( region, *next ) ) continue;
+			set_cell( region, *next );
+			stack.push_back( *next );
+		}
+	}
+
+	return region_size;
+
+}
+
 
 /** **********************************************************************
  *  @author Adam Wood
@@ -195,8 +898,24 @@ void StrandsBoard::find_all_words() {
  *  @par Description
  *  Recursively finds a solution to the NYT Strands board by finding 
  *  combinations of found words on the board that don't overlap and use
- *  every space on the board. The recursion will stop after a specified
- *  number of calls lest the function run forver. The solutions are stored
+ *  every space on the board. Each call looks for the uncovered letter
+ *  with the fewest words left that could cover it and only tries those
+ *  words, since one of them has to be in any solution. If some letter 
+ *  has no words left the working solution can't be finished and the
+ *  call returns right away. 
+ *
+ *  The number of letters left also bounds how many words can cover them,
+ *  from the lengths of the longest and shortest found words, so a call
+ *  that can't end with an allowed number of words returns right away.
+ *
+ *  The uncovered letters are also split into connected regions. A region
+ *  smaller than the shortest word can never be covered, so the call
+ *  returns. When there are several regions, no word can span two of
+ *  them, so each region is solved on its own and every combination of
+ *  their solutions is a solution, instead of searching every combination
+ *  over and over. If any region has no solution, neither does the board.
+ *  The recursion will stop once the budget runs out lest the function 
+ *  run forver. The solutions are stored
  *  in the solutions member function which contains vectors of indicies
  *  of the found_words member which contain the words of the solution.
  *  
@@ -204,14 +923,21 @@ void StrandsBoard::find_all_words() {
  *  This function is used by the public function 
  *  StrandsBoard::find_solution_from_words.
  *
+ *  @param[in] word_cells the positions covered by each found word.
+ *  @param[in, out] covered the positions covered by the working solution.
  *  @param[in, out] indicies the vector of indicies linking to the words
  *  in the working solution via the found_words member.
  *  @param[in] total_chars the number of characters of the board used
  *  in the working solution.
- *  @param[in,out] depth the number of times the recursive function
- *  has been called so far.
- *  @param[in] max_depth the maximum number of times the recursive function
- *  may be called.
+ *  @param[in] min_words the fewest words that still have to be added.
+ *  @param[in] max_words the most words that may still be added.
+ *  @param[in] first_spangram words touching two opposite edges with a
+ *  lower index than this may not be added. 0 allows every word.
+ *  @param[in] partial true when solving one region of the board, whose
+ *  solutions are only parts of solutions to the board.
+ *  @param[in,out] budget the limits on the search, shared by every 
+ *  thread solving the board.
+ *  @param[in, out] found the list the solutions are added to.
  *
  *
  *  @par Example
@@ -220,72 +946,450 @@ void StrandsBoard::find_all_words() {
     vector<int> indicies;
 	indicies.reserve( found_words.size() );
 
-	int recursion_call_number = 0;
+	SolveBudget budget( solve_options );
 	find_solution_from_words_rec ( 
+		word_cells,
+		covered,
 		indicies, 
 		0, 
-		recursion_call_number, 
-		int( 1e6 ) 
+		0,
+		numeric_limits<int>::max(),
+		0,
+		false,
+		budget, 
+		solutions
 	);
 
     @endverbatim
 ************************************************************************/
+template <typename Cells>
 void StrandsBoard::find_solution_from_words_rec ( 
+	const vector<Cells> & word_cells,
+	Cells & covered,
 	vector<int> & indicies, 
 	int total_chars, 
-	int & depth, 
-	int max_depth 
+	int min_words,
+	int max_words,
+	int first_spangram,
+	bool partial,
+	SolveBudget & budget,
+	vector<vector<int>> & found
 ) {
 	
 	// if we have searched too long or we have used too many characters
-	if( depth >= max_depth || total_chars > size() ) return;
+	if( budget.spent() || total_chars > size() ) return;
 
 	// if we have used all the characters on the board, we have found a solution
 	if( total_chars == size() ) {
-		solutions.emplace_back( indicies );
+		if( min_words > 0 ) return;
+		found.emplace_back( indicies );
+		sort( found.back().begin(), found.back().end() );
+		if( !partial ) budget.add_solution();
 		return;
 	}
 
-	// find the index of the last word used in our working solution
-	// we only consider words with an index greater than this last word
-	// in our working solution as to find combinations rather than permutations
-	int last_index = indicies.empty() ? -1 : indicies.back();
+	if( found_words.empty() ) return;
+
+	// found_words is sorted by length, so covering the letters left takes
+	// at least as many words as it would with only the longest word and 
+	// at most as many as it would with only the shortest
+	int longest = static_cast<int>( found_words.front().word.size() );
+	int shortest = static_cast<int>( found_words.back().word.size() );
+	int letters_left = size() - total_chars;
+	if( ( letters_left + longest - 1 ) / longest > max_words || letters_left / shortest < min_words ) return;
+
+	// the letters connected to the first uncovered letter
+	int start = 0;
+	while( test_cell( covered, start ) ) start++;
+	Cells region = no_cells<Cells>( size() );
+	int region_size = fill_region( covered, start, region );
+
+	// no word fits in a region this small
+	if( region_size < shortest ) return;
+
+	// the uncovered letters are split into more than one region
+	if( region_size < letters_left ) {
+
+		vector<Cells> regions = { region };
+		vector<int> region_sizes = { region_size };
+		Cells seen = covered;
+		seen |= region;
+		for( ; start < size(); start++ ) {
+			if( test_cell( seen, start ) ) continue;
+			region = no_cells<Cells>( size() );
+			region_size = fill_region( covered, start, region );
+			if( region_size < shortest ) return;
+			regions.push_back( region );
+			region_sizes.push_back( region_size );
+			seen |= region;
+		}
 
-	for( int i = last_index + 1; i < get_found_words_amount(); i++ ) {
+		// bound the words each region takes the same way, since the 
+		// regions together have to take an allowed number of words
+		int fewest_words = 0;
+		int most_words = 0;
+		for( auto letters : region_sizes ) {
+			fewest_words += ( letters + longest - 1 ) / longest;
+			most_words += letters / shortest;
+		}
+		if( fewest_words > max_words || most_words < min_words ) return;
+
+		// solve each region with every letter outside it covered
+		vector<vector<vector<int>>> region_solutions( regions.size() );
+		for( size_t r = 0; r < regions.size(); r++ ) {
+
+			Cells region_covered = no_cells<Cells>( size() );
+			for( int cell = 0; cell < size(); cell++ )
+				if( !test_cell( regions[r], cell ) ) set_cell( region_covered, cell );
+
+			// the other regions take the rest of the words
+			int others_fewest = fewest_words - ( region_sizes[r] + longest - 1 ) / longest;
+			int others_most = most_words - region_sizes[r] / shortest;
+
+			vector<int> region_indicies;
+			find_solution_from_words_rec( 
+				word_cells,
+				region_covered,
+				region_indicies,
+				size() - region_sizes[r],
+				min_words - others_most,
+				max_words - others_fewest,
+				first_spangram,
+				true,
+				budget,
+				region_solutions[r]
+			);
+
+			// a region that can't be covered means the board can't be
+			if( region_solutions[r].empty() ) return;
 
-		// check if word overlaps with words in our working solution
-		// if so it cannot be part of the solution
-		bool overlapping = false;
-		
-		for( auto idx : indicies ) {
-			if( found_words[i].overlap( found_words[ idx ] ) ) {
-				overlapping = true;
-				break;
+		}
+
+		// every combination of the regions' solutions with an allowed
+		// number of words is a solution
+		vector<size_t> choice( regions.size(), 0 );
+		while( !budget.spent() ) {
+
+			int words_added = 0;
+			for( size_t r = 0; r < choice.size(); r++ )
+				words_added += static_cast<int>( region_solutions[r][ choice[r] ].size() );
+
+			if( words_added >= min_words && words_added <= max_words ) {
+				found.emplace_back( indicies );
+				for( size_t r = 0; r < choice.size(); r++ ) {
+					auto & words = region_solutions[r][ choice[r] ];
+					found.back().insert( found.back().end(), words.begin(), words.end() );
+				}
+				sort( found.back().begin(), found.back().end() );
+				if( !partial ) budget.add_solution();
 			}
+			budget.spend();
+
+			// step to the next combination like an odometer
+			size_t r = 0;
+			while( r < choice.size() && ++choice[r] == region_solutions[r].size() )
+				choice[r++] = 0;
+			if( r == choice.size() ) break;
+
 		}
-		
 
-		if( overlapping ) continue;
+		return;
+
+	}
+
+	// nothing can cover some letter so there is no solution from here
+	int best_cell = most_constrained_cell( word_cells, covered );
+	if( best_cell == -1 ) return;
+
+	for( auto i : found_cell_words[ best_cell ] ) {
+
+		// check if word overlaps with words in our working solution
+		// if so it cannot be part of the solution
+		if( cells_intersect( word_cells[i], covered ) ) continue;
+
+		// a spangram before the one chosen would find the solution twice
+		if( i < first_spangram && found_words[i].spangram() ) continue;
 
 		// add word to solution list
 		indicies.push_back(i);
+		covered |= word_cells[i];
 
-		depth++;
+		budget.spend();
 		find_solution_from_words_rec ( 
+			word_cells,
+			covered,
 			indicies, 
 			total_chars + static_cast<int>( found_words[i].word.size() ), 
-			depth, 
-			max_depth
+			min_words - 1,
+			max_words - 1,
+			first_spangram,
+			partial,
+			budget,
+			found
 		);
 
 		// remove word from solution list
+		covered ^= word_cells[i];
 		indicies.pop_back();
 
+		if( budget.spent() ) return;
+
 	}
 
 }
 
 
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Does the work of StrandsBoard::find_solution_from_words using Cells
+ *  as the type for sets of positions on the board.
+ *
+ *  When solve_options asks for one spangram, the search starts from
+ *  each word touching two opposite edges in turn as the spangram. The
+ *  words like it after it may still be added as theme words, but the
+ *  ones before it may not, since the solutions with those were already
+ *  found starting from them.
+ *
+ *  @param[in,out] budget the limits on the search.
+************************************************************************/
+template <typename Cells>
+void StrandsBoard::find_solution_from_words_with( SolveBudget & budget ) { 
+
+	// make sure the words covering each letter match found_words
+	index_found_words();
+
+	vector<int> indicies;
+	indicies.reserve( found_words.size() );
+
+	// the positions of every word so checking for overlap is a single and
+	vector<Cells> word_cells( found_words.size(), no_cells<Cells>( size() ) );
+	for( size_t i = 0; i < found_words.size(); i++ )
+		for( auto cell : found_words[i].path )
+			set_cell( word_cells[i], cell );
+
+	// initialize the chars_used variable
+	// however many characters are already marked as used
+	int chars_used = 0;
+	Cells covered = no_cells<Cells>( size() );
+	for( int y = 0; y < height; y++ ) {
+		for ( int x = 0; x < width; x++ ) {
+			if ( !used[y][x] ) continue;
+			chars_used++;
+			set_cell( covered, linearize_coor( x, y ) );
+		}
+	}
+
+	int min_words = solve_options.min_words;
+	int max_words = solve_options.max_words > 0 ? solve_options.max_words : numeric_limits<int>::max();
+
+	// a working solution the search continues from
+	struct SolveTask {
+		Cells covered;
+		vector<int> indicies;
+		int total_chars;
+		int first_spangram;
+	};
+
+	vector<SolveTask> tasks;
+
+	if( solve_options.one_spangram ) {
+		for( size_t i = 0; i < found_words.size(); i++ ) {
+			if( !found_words[i].spangram() || cells_intersect( word_cells[i], covered ) ) continue;
+			tasks.push_back( { covered, { int( i ) }, chars_used + static_cast<int>( found_words[i].word.size() ), int( i ) } );
+			tasks.back().covered |= word_cells[i];
+		}
+	} else {
+		tasks.push_back( { covered, indicies, chars_used, 0 } );
+	}
+
+	int threads = solve_threads > 0 ? solve_threads : int( thread::hardware_concurrency() );
+
+	if ( threads <= 1 ) {
+		for( size_t t = 0; t < tasks.size() && !budget.spent(); t++ ) {
+			int words = static_cast<int>( tasks[t].indicies.size() );
+			tasks[t].indicies.reserve( found_words.size() );
+			find_solution_from_words_rec ( 
+				word_cells,
+				tasks[t].covered,
+				tasks[t].indicies, 
+				tasks[t].total_chars, 
+				min_words - words,
+				max_words - words,
+				tasks[t].first_spangram,
+				false,
+				budget,
+				solutions
+			);
+		}
+		return;
+	}
+
+	// split the top of the search tree into more tasks by choosing the 
+	// next few words the same way the recursion would. Each choice of word
+	// for a letter leads to different solutions so no solution is found 
+	// twice.
+	for( int level = 0; level < SOLVE_SPLIT_DEPTH && tasks.size() < size_t( threads ) * SOLVE_TASKS_PER_THREAD; level++ ) {
+
+		vector<SolveTask> next_tasks;
+		for( auto & task : tasks ) {
+
+			// leave finished solutions for the recursion to record
+			if( task.total_chars >= size() ) {
+				next_tasks.push_back( task );
+				continue;
+			}
+
+			// leave tasks that can't have more words for the recursion too
+			if( int( task.indicies.size() ) >= max_words ) {
+				next_tasks.push_back( task );
+				continue;
+			}
+
+			int best_cell = most_constrained_cell( word_cells, task.covered );
+			if( best_cell == -1 ) continue;
+
+			for( auto i : found_cell_words[ best_cell ] ) {
+				if( cells_intersect( word_cells[i], task.covered ) ) continue;
+				if( i < task.first_spangram && found_words[i].spangram() ) continue;
+				next_tasks.push_back( task );
+				next_tasks.back().covered |= word_cells[i];
+				next_tasks.back().indicies.push_back( i );
+				next_tasks.back().total_chars += static_cast<int>( found_words[i].word.size() );
+				budget.spend();
+			}
+
+		}
+		tasks.swap( next_tasks );
+
+	}
+
+	// each thread takes the next task nobody has taken yet until there
+	// are none left or the budget runs out
+	vector<vector<vector<int>>> task_solutions( tasks.size() );
+	atomic<size_t> next_task( 0 );
+
+	auto worker = [&]() {
+		for( size_t t = next_task++; t < tasks.size() && !budget.spent(); t = next_task++ ) {
+			int words = static_cast<int>( tasks[t].indicies.size() );
+			tasks[t].indicies.reserve( found_words.size() );
+			find_solution_from_words_rec ( 
+				word_cells,
+				tasks[t].covered,
+				tasks[t].indicies, 
+				tasks[t].total_chars, 
+				min_words - words,
+				max_words - words,
+				tasks[t].first_spangram,
+				false,
+				budget,
+				task_solutions[t]
+			);
+		}
+	};
+
+	vector<thread> pool;
+	for( size_t i = 1; i < min( size_t( threads ), tasks.size() ); i++ )
+		pool.emplace_back( worker );
+	worker();
+	for( auto & t : pool )
+		t.join();
+
+	// merge in task order so the solutions don't depend on which thread
+	// finished first
+	for( auto & found : task_solutions )
+		for( auto & solution : found )
+			solutions.push_back( move( solution ) );
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Finds solutions to the board as an exact cover problem: every unused
+ *  letter is a column that has to be covered exactly once, and every
+ *  found word that doesn't use a used letter is a row covering its
+ *  letters. DancingLinks then always continues from the letter with the
+ *  fewest words left that could cover it, and drops a branch as soon as
+ *  some letter can't be covered anymore. Like the bitmask search
+ *  it stops once the budget runs out. 
+ *
+ *  When solve_options asks for one spangram, each word touching two
+ *  opposite edges is added twice: once as the spangram, covering one 
+ *  more column only spangrams cover, and once as a theme word. Each of
+ *  those words also has a secondary column its theme word row covers,
+ *  and the spangram rows of the words after it cover too, so the 
+ *  spangram is always the first such word in a solution and no solution
+ *  is found twice.
+ *
+ *  @param[in,out] budget the limits on the search.
+************************************************************************/
+void StrandsBoard::find_solution_dancing_links( SolveBudget & budget ) {
+
+	// number the unused letters as columns
+	vector<int> cell_column( size(), -1 );
+	int columns = 0;
+	for( int cell = 0; cell < size(); cell++ )
+		if ( !used[ cell / width ][ cell % width ] )
+			cell_column[ cell ] = columns++;
+
+	// the column only spangrams cover
+	int spangram_column = columns;
+	if ( solve_options.one_spangram ) columns++;
+
+	// the words that could be the spangram, each with a secondary column
+	vector<int> spangrams;
+	vector<int> word_columns;
+	for( size_t i = 0; i < found_words.size() && solve_options.one_spangram; i++ ) {
+		if ( !found_words[i].spangram() ) continue;
+		bool free = true;
+		for( auto cell : found_words[i].path )
+			free = free && cell_column[ cell ] != -1;
+		if ( free ) spangrams.push_back( static_cast<int>( i ) );
+	}
+
+	DancingLinks links( columns, static_cast<int>( spangrams.size() ) );
+
+	size_t next_spangram = 0;
+	for( size_t i = 0; i < found_words.size(); i++ ) {
+
+		word_columns.clear();
+		for( auto cell : found_words[i].path )
+			word_columns.push_back( cell_column[ cell ] );
+
+		// words over used letters can't be part of a solution
+		if ( find( word_columns.begin(), word_columns.end(), -1 ) != word_columns.end() )
+			continue;
+
+		if ( next_spangram == spangrams.size() || spangrams[ next_spangram ] != int( i ) ) {
+			links.add_row( static_cast<int>( i ), word_columns );
+			continue;
+		}
+
+		// as a theme word it blocks the spangrams after it
+		size_t cell_count = word_columns.size();
+		word_columns.push_back( columns + static_cast<int>( next_spangram ) );
+		links.add_row( static_cast<int>( i ), word_columns );
+
+		// as the spangram it blocks the theme words before it
+		word_columns.resize( cell_count );
+		word_columns.push_back( spangram_column );
+		for( size_t before = 0; before < next_spangram; before++ )
+			word_columns.push_back( columns + static_cast<int>( before ) );
+		links.add_row( static_cast<int>( i ), word_columns );
+
+		next_spangram++;
+
+	}
+
+	int max_words = solve_options.max_words > 0 ? solve_options.max_words : numeric_limits<int>::max();
+	links.search( solutions, budget, solve_options.min_words, max_words );
+
+}
+
 
 /** **********************************************************************
  *  @author Adam Wood
@@ -293,13 +1397,17 @@ void StrandsBoard::find_solution_from_words_rec (
  *  @par Description
  *  Recursively finds a solution to the NYT Strands board by finding 
  *  combinations of found words on the board that don't overlap and use
- *  every space on the board. The recursion will stop after a million
- *  number of calls lest the function run forver. The solutions are stored
+ *  every space on the board. The search stops at the limits in the 
+ *  solve_options member, a million calls by default, lest the function 
+ *  run forver. Solutions with too few or too many words are never 
+ *  recorded. The solutions are stored
  *  in the solutions member function which contains vectors of indicies
  *  of the found_words member which contain the words of the solution.
  *  The function StrandsBoard::find_all_words should be called before
  *  this one can actual do anything.
  *  
+ *  @returns why the search stopped, how many calls and solutions it
+ *  took and how long it ran. Also kept in the solve_stats member.
  *
  *  @par Example
  *  @verbatim
@@ -327,30 +1435,43 @@ void StrandsBoard::find_solution_from_words_rec (
 
     @endverbatim
 ************************************************************************/
-void StrandsBoard::find_solution_from_words() { 
+SolveStats StrandsBoard::find_solution_from_words() { 
 
-	vector<int> indicies;
-	indicies.reserve( found_words.size() );
+	auto start = chrono::steady_clock::now();
 
 	solutions.clear();
 
-	// initialize the chars_used variable
-	// however many characters are already marked as used
-	int chars_used = 0;
-	for( int y = 0; y < height; y++ )
-		for ( int x = 0; x < width; x++ )
-			chars_used += static_cast<int>( used[y][x] );
+	SolveBudget budget( solve_options );
 
-	// create a variable to keep track of number of recursive calls
-	// we quit the recurssion after this variable reaches an arbitrary
-	// large number such as a million.
-	int recursion_call_number = 0;
-	find_solution_from_words_rec ( 
-		indicies, 
-		chars_used, 
-		recursion_call_number, 
-		int( 1e6 ) 
-	);
+	if ( solve_engine == SOLVE_DANCING_LINKS ) {
+		find_solution_dancing_links( budget );
+	} else {
+		// use the smallest set of positions that fits the board
+		switch ( cell_engine ) {
+			case CELLS_64:
+				find_solution_from_words_with<uint64_t>( budget );
+				break;
+			case CELLS_128:
+				find_solution_from_words_with<cells128_t>( budget );
+				break;
+			default:
+				find_solution_from_words_with<DynamicCells>( budget );
+				break;
+		}
+	}
+
+	// threads can each find a solution after there are enough
+	if ( solve_options.max_solutions > 0 && int( solutions.size() ) > solve_options.max_solutions )
+		solutions.resize( solve_options.max_solutions );
+
+	chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+
+	solve_stats.stop = budget.stop_reason;
+	solve_stats.calls = budget.calls;
+	solve_stats.solutions = static_cast<int>( solutions.size() );
+	solve_stats.ms = ms.count();
+
+	return solve_stats;
 
 }
 
@@ -395,8 +1516,25 @@ void StrandsBoard::find_solution_from_words() {
     @endverbatim
 ************************************************************************/
 void StrandsBoard::find_hint_matches( bool ** coors, vector<PuzzleWord> & matching ) {
-	// loop through every found word and if it's coordinates match up with
-	// the given coordinates, add a copy of it to the maching vector
-	for ( auto & pw : found_words )
-		if( pw.total_overlap( coors ) ) matching.emplace_back( pw );
+
+	// turn the hint into a word covering the same positions so 
+	// each found word can be compared to it directly
+	vector<uint16_t> hint_path;
+	for( int y = 0; y < height; y++ )
+		for ( int x = 0; x < width; x++ )
+			if( coors[y][x] ) 
+				hint_path.push_back( static_cast<uint16_t>( linearize_coor( x, y ) ) );
+	if ( hint_path.empty() ) return;
+
+	// the hint's mask depends on the board size, which may not have been
+	// set by a search yet or may be left over from another board
+	PuzzleWord::height = height;
+	PuzzleWord::width = width;
+	PuzzleWord hint( "", hint_path );
+
+	// only the words covering the first letter of the hint can match it.
+	// add a copy of each one covering exactly the hint's positions. 
+	// words_at has none before any words are found
+	for ( auto index : words_at( hint_path[0] % width, hint_path[0] / width ) )
+		if( found_words[ index ].same_cells( hint ) ) matching.emplace_back( found_words[ index ] );
 }
@@ -150,10 +150,9 @@ bool get_board( vector<string> & board_string, int width, int height ) {
     @endverbatim
 ************************************************************************/
 void find_word_start( PuzzleWord & pw, int & startx, int & starty ) {
-	// do a linear search and stop when we find the first square
-	for( starty = 0; starty < PuzzleWord::height; starty++ )
-		for( startx = 0; startx < PuzzleWord::width; startx++ )
-			if( pw.coordinates[starty][startx] == 1 ) return;
+	// the path starts at the first letter
+	startx = pw.path[0] % PuzzleWord::width;
+	starty = pw.path[0] / PuzzleWord::width;
 }
 
 
@@ -365,18 +364,13 @@ void StrandsBoard::delete_word( string word ) {
 		choice = 0;
 
 	// set the letters used in the word as used on the board
-	for( int y = 0; y < height; y++ ) 
-		for( int x = 0; x < width; x++ ) 
-			if( found_words[ candidate_indicies[choice] ].coordinates[y][x] ) used[y][x] = true;
+	for( auto cell : found_words[ candidate_indicies[choice] ].path ) 
+		used[ cell / width ][ cell % width ] = true;
 
 
-	// delete overlapping words
-	PuzzleWord pw = found_words[ candidate_indicies[choice] ];
-	for( auto it = found_words.begin(); it != found_words.end(); ) {
-		if( it->overlap( pw ) ) {
-			it = found_words.erase( it );
-		} else it++;
-	}
+	// drop the words that overlap it. the board isn't searched again, but
+	// found_words is refilled from every word in the index
+	find_all_words();
 
 	std::cout << "The word has been deleted\n\n";
 
@@ -413,7 +407,9 @@ void menu() {
 
 	StrandsBoard board( board_string );
 
-	// find all of the words in the board
+	// find all of the words and solutions in the board using every core
+	board.search_threads = 0;
+	board.solve_threads = 0;
 	board.find_all_words();
 
 	int option = -1;
@@ -10,6 +10,7 @@
 #include <string>
 #include <sstream>
 #include <set>
+#include <unordered_set>
 #include <cstring>
 #include <fstream>
 #include <algorithm>
@@ -17,6 +18,13 @@
 #include <limits>
 #include <iomanip>
 #include <new>
+#include <cstdint>
+#include <bit>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
 
 using namespace std;
 
@@ -32,8 +40,17 @@ void free_2d( T * * & ptr );
 ************************************************************************/
 const int MIN_WORD_LEN = 4;
 
+/** **********************************************************************
+*  @brief
+*  Most letters StrandsBoard::set_board changes one at a time before it
+*  finds the words on the whole board again instead.
+************************************************************************/
+const int MAX_LETTER_EDITS = 4;
+
 struct PuzzleWord;
 struct LetterNode;
+class LetterArena;
+class Dictionary;
 
 /** **********************************************************************
 *  @brief
@@ -44,22 +61,415 @@ struct LetterNode;
 
 /** **********************************************************************
 *  @brief
-*  Node in a prefix tree.
+*  Node in a prefix tree. Every node other than the root comes from a 
+*  LetterArena, which frees the whole tree at once.
 ************************************************************************/
 struct LetterNode {
 
 	LetterNode * children [ LETTER_NODE_MAX ];
     /**< Children nodes. One for 26 letters of the alphabet plus one extra */
 
+	bool terminal;
+    /**< True if a word ends at this node. */
+
 	LetterNode();
-	~LetterNode();
-	bool contains( string word );
-	void insert( string word );
+	bool contains( const string & word ) const;
+	void insert( const string & word, LetterArena & arena );
 	static int char_to_index( char c );
 	LetterNode * & operator []( char c );
 };
 
 
+/** **********************************************************************
+*  @brief
+*  Bump allocator for the nodes of a LetterNode prefix tree. Nodes are 
+*  handed out from a few large blocks, each twice the size of the last,
+*  and are all freed together when the arena is destroyed.
+************************************************************************/
+class LetterArena {
+
+	public:
+
+		LetterArena();
+
+		~LetterArena();
+
+		LetterArena( const LetterArena & other ) = delete;
+
+		LetterArena & operator=( const LetterArena & other ) = delete;
+
+		LetterNode * allocate();
+
+		size_t size() const;
+
+	private:
+
+		vector<LetterNode *> blocks;
+    	/**< Blocks of nodes, each twice the size of the one before. */
+
+		size_t block_size;
+    	/**< Number of nodes in the last block. */
+
+		size_t block_used;
+    	/**< Number of nodes handed out from the last block. */
+
+		size_t total;
+    	/**< Number of nodes handed out from every block. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Default location of the plain text words file.
+************************************************************************/
+#define DICTIONARY_TEXT_FILE "words"
+
+/** **********************************************************************
+*  @brief
+*  Default location of the precompiled dictionary made by compile_words.
+************************************************************************/
+#define DICTIONARY_BINARY_FILE "words.dict"
+
+/** **********************************************************************
+*  @brief
+*  Bits of DictNode::mask holding which of the 26 letters have a child.
+************************************************************************/
+const uint32_t DICT_LETTER_BITS = ( 1u << 26 ) - 1;
+
+/** **********************************************************************
+*  @brief
+*  Bit of DictNode::mask set when a word ends at the node.
+************************************************************************/
+const uint32_t DICT_TERMINAL = 1u << 26;
+
+/** **********************************************************************
+*  @brief
+*  Shift of the bits of DictNode::mask holding the most letters that can
+*  follow the node before a word ends.
+************************************************************************/
+const uint32_t DICT_HEIGHT_SHIFT = 27;
+
+/** **********************************************************************
+*  @brief
+*  Largest height stored in a DictNode. It stands for that many letters
+*  or more.
+************************************************************************/
+const uint32_t DICT_HEIGHT_MAX = 31;
+
+/** **********************************************************************
+*  @brief
+*  Index returned when a node has no child for a letter.
+************************************************************************/
+const uint32_t DICT_NO_NODE = 0xFFFFFFFFu;
+
+/** **********************************************************************
+*  @brief
+*  Node in the flat minimized word graph used by the Dictionary. The 
+*  children of a node are stored next to each other in alphabetical order
+*  starting at first, so the child for a letter is found by counting the
+*  set bits of mask below that letter. Nodes with identical subtrees 
+*  share the same block of children. This is also the on disk layout of
+*  the precompiled dictionary.
+************************************************************************/
+struct DictNode {
+
+	uint32_t mask;
+    /**< One bit per letter that has a child plus DICT_TERMINAL, with the
+	height of the node above DICT_HEIGHT_SHIFT. */
+
+	uint32_t first;
+    /**< Index of the first child of the node. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Letters of a board, used to cut a Dictionary down to the words that
+*  could possibly be spelled on it.
+************************************************************************/
+struct BoardLetters {
+
+	int counts[26];
+    /**< How many times each letter appears on the board. */
+
+	uint32_t follows[26];
+    /**< For each letter, one bit per letter found next to it somewhere
+	on the board. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Read-only dictionary of english words. The dictionary is only loaded
+*  once per process and the result is shared by every StrandsBoard. If
+*  a precompiled dictionary exists it is memory mapped and used in place,
+*  otherwise the words file is parsed. Since nothing is modified after
+*  construction, any number of threads may read from it at once.
+************************************************************************/
+class Dictionary {
+
+	public:
+
+		static const Dictionary & shared();
+
+		static bool compile( 
+			const char * text_path, 
+			const char * binary_path, 
+			ostream & out = std::cout 
+		);
+
+		Dictionary();
+
+		Dictionary( const Dictionary & source, const BoardLetters & letters );
+
+		~Dictionary();
+
+		Dictionary( const Dictionary & other ) = delete;
+
+		Dictionary & operator=( const Dictionary & other ) = delete;
+
+		bool has_prefix( const string & prefix ) const;
+
+		bool contains( const string & word ) const;
+
+		int size() const;
+
+		uint32_t root() const;
+
+		uint32_t child( uint32_t node, char c ) const;
+
+		bool is_word( uint32_t node ) const;
+
+		int longest_from( uint32_t node ) const;
+
+	private:
+
+		const DictNode * nodes;
+    	/**< Minimized word graph of all english words with a length of at
+		least 4 and no non-letters. Points into either storage or the
+		memory mapped dictionary file. */
+
+		uint32_t node_count;
+    	/**< Number of nodes in the prefix tree. */
+
+		int word_count;
+    	/**< Number of words in the dictionary. */
+
+		vector<DictNode> storage;
+    	/**< Holds the nodes when they were built from the words file. */
+
+		void * mapping;
+    	/**< Start of the memory mapped dictionary file or nullptr. */
+
+		size_t mapping_size;
+    	/**< Size in bytes of the memory mapped dictionary file. */
+
+		bool load_binary( const char * path );
+
+		void load_text( const char * path );
+
+		static void build( const LetterNode & root, vector<DictNode> & flat );
+
+		uint32_t find( const string & word ) const;
+
+		DictNode copy_fitting( 
+			const Dictionary & source, 
+			uint32_t node, 
+			int previous, 
+			const BoardLetters & letters, 
+			int * counts 
+		);
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Set of positions on a board of up to 128 cells, one bit per position.
+************************************************************************/
+typedef unsigned __int128 cells128_t;
+
+
+/** **********************************************************************
+*  @brief
+*  Set of positions on a board of any size, one bit per position. Used
+*  by the search and solver on boards too large for cells128_t.
+************************************************************************/
+class DynamicCells {
+
+	public:
+
+		DynamicCells();
+
+		DynamicCells( int size );
+
+		void set( int cell );
+
+		void reset( int cell );
+
+		bool test( int cell ) const;
+
+		bool intersects( const DynamicCells & other ) const;
+
+		DynamicCells & operator |=( const DynamicCells & other );
+
+		DynamicCells & operator ^=( const DynamicCells & other );
+
+		bool operator ==( const DynamicCells & other ) const;
+
+		size_t hash() const;
+
+	private:
+
+		vector<uint64_t> blocks;
+    	/**< 64 positions per block with (x,y) stored as bit x + width * y. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Which type the search and solver use as a set of positions. Chosen
+*  by the StrandsBoard from its size so small boards use a single 
+*  integer.
+************************************************************************/
+enum CellEngine {
+	CELLS_64,
+    /**< Boards of up to 64 cells use uint64_t. */
+	CELLS_128,
+    /**< Boards of up to 128 cells use cells128_t. */
+	CELLS_DYNAMIC
+    /**< Larger boards use DynamicCells. */
+};
+
+
+/** **********************************************************************
+*  @brief
+*  How find_all_words walks the paths on the board.
+************************************************************************/
+enum SearchEngine {
+	SEARCH_RECURSIVE,
+    /**< One recursive call per letter of the working word. */
+	SEARCH_ITERATIVE
+    /**< A loop over an explicit stack of SearchFrame, so the longest
+	word is not limited by the call stack. */
+};
+
+
+/** **********************************************************************
+*  @brief
+*  One letter of the working word in the iterative word search.
+************************************************************************/
+struct SearchFrame {
+
+	int cell;
+    /**< Linearized position of the letter. */
+
+	uint32_t node;
+    /**< Dictionary node of the working word up to this letter. */
+
+	const int * next;
+    /**< The next neighbor of cell to try. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Returns an empty set of positions for a board with a given number of
+*  cells.
+************************************************************************/
+template <typename Cells>
+Cells no_cells( int /* size */ ) {
+	return Cells( 0 );
+}
+
+template <>
+DynamicCells no_cells<DynamicCells>( int size );
+
+/** **********************************************************************
+*  @brief
+*  Adds a position to a set of positions.
+************************************************************************/
+template <typename Cells>
+void set_cell( Cells & cells, int cell ) {
+	cells |= Cells( 1 ) << cell;
+}
+
+void set_cell( DynamicCells & cells, int cell );
+
+/** **********************************************************************
+*  @brief
+*  Removes a position from a set of positions.
+************************************************************************/
+template <typename Cells>
+void reset_cell( Cells & cells, int cell ) {
+	cells &= ~( Cells( 1 ) << cell );
+}
+
+void reset_cell( DynamicCells & cells, int cell );
+
+/** **********************************************************************
+*  @brief
+*  Checks if a position is in a set of positions.
+************************************************************************/
+template <typename Cells>
+bool test_cell( const Cells & cells, int cell ) {
+	return ( cells >> cell ) & 1;
+}
+
+bool test_cell( const DynamicCells & cells, int cell );
+
+/** **********************************************************************
+*  @brief
+*  Checks if two sets of positions have any position in common.
+************************************************************************/
+template <typename Cells>
+bool cells_intersect( const Cells & a, const Cells & b ) {
+	return ( a & b ) != 0;
+}
+
+bool cells_intersect( const DynamicCells & a, const DynamicCells & b );
+
+/** **********************************************************************
+*  @brief
+*  Mixes a set of positions down to a hash value.
+************************************************************************/
+template <typename Cells>
+size_t hash_cells( const Cells & cells ) {
+	uint64_t h = uint64_t( cells );
+	if constexpr ( sizeof( Cells ) > sizeof( uint64_t ) )
+		h ^= uint64_t( cells >> 64 ) * 0x9e3779b97f4a7c15ull;
+	return size_t( h ^ ( h >> 29 ) );
+}
+
+size_t hash_cells( const DynamicCells & cells );
+
+
+/** **********************************************************************
+*  @brief
+*  Largest board, in cells, whose words are tracked with a 64 bit mask.
+************************************************************************/
+const int BITBOARD_MAX_CELLS = 64;
+
+/** **********************************************************************
+*  @brief
+*  Edges of the board a word can touch, as bits of PuzzleWord::edges.
+************************************************************************/
+enum BoardEdge {
+	EDGE_TOP = 1,
+    /**< The word has a letter in the top row. */
+	EDGE_BOTTOM = 2,
+    /**< The word has a letter in the bottom row. */
+	EDGE_LEFT = 4,
+    /**< The word has a letter in the leftmost column. */
+	EDGE_RIGHT = 8
+    /**< The word has a letter in the rightmost column. */
+};
+
 /** **********************************************************************
 *  @brief
 *  Represents a single word on the Strands board.
@@ -68,11 +478,18 @@ struct PuzzleWord {
 	
 	string word;
     /**< The word on the board. */
-	int ** coordinates;
-    /**< A 2d array of the board representing the position of 
-	each letter in the word on the board with the first letter being marked 1
-	the second letter being marked 2, etc, and every position that isn't in 
-	the word marked 0. */
+
+	vector<uint16_t> path;
+    /**< The position of each letter of the word on the board in order,
+	with (x,y) stored as x + width * y. */
+
+	uint64_t cells;
+    /**< One bit per position on the board that the word covers, with
+	(x,y) stored as bit x + width * y. Only used when the board has at
+	most BITBOARD_MAX_CELLS positions, otherwise it is zero. */
+
+	uint8_t edges;
+    /**< The BoardEdge bits of every edge of the board the word touches. */
 
 
 	inline static int width;
@@ -82,17 +499,17 @@ struct PuzzleWord {
     /**< Height of the strands board. */
 
 	PuzzleWord();
-	PuzzleWord( PuzzleWord & other );
-	PuzzleWord( PuzzleWord && other );
-	void move( PuzzleWord & other );
-	PuzzleWord& operator=(PuzzleWord& other);
-	PuzzleWord& operator=(PuzzleWord&& other);
-	PuzzleWord( string w, int ** coor_original );
-	~PuzzleWord();
+	PuzzleWord( const string & w, const vector<uint16_t> & p );
 	
-	friend void swap( PuzzleWord & a, PuzzleWord & b );
+	static bool bitboard();
+
+	bool overlap ( const PuzzleWord & other ) const;
+
+	bool same_cells ( const PuzzleWord & other ) const;
 
-	bool overlap ( PuzzleWord & other );
+	bool covers ( int x, int y ) const;
+
+	bool spangram () const;
 
 	template <typename T>
 	bool total_overlap ( T ** coors );
@@ -108,6 +525,305 @@ struct PuzzleWord {
 
 bool operator < ( const PuzzleWord & lhs, const PuzzleWord & rhs );
 
+/** **********************************************************************
+*  @brief
+*  How find_solution_from_words searches for sets of words covering the
+*  board.
+************************************************************************/
+enum SolveEngine {
+	SOLVE_BITMASK,
+    /**< Tries combinations of words using a set of positions per word,
+	always continuing from the letter covered by the fewest words. */
+	SOLVE_DANCING_LINKS
+    /**< Exact cover search with DancingLinks, always continuing from the
+	letter covered by the fewest words. */
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Number of words the parallel solver chooses before handing the rest of
+*  the search to the threads.
+************************************************************************/
+const int SOLVE_SPLIT_DEPTH = 3;
+
+
+/** **********************************************************************
+*  @brief
+*  The parallel solver stops splitting the search once it has this many
+*  tasks per thread, so a thread that finishes early can take another.
+************************************************************************/
+const int SOLVE_TASKS_PER_THREAD = 8;
+
+
+/** **********************************************************************
+*  @brief
+*  Limits and rules for a search for solutions. A limit of 0 means no
+*  limit.
+************************************************************************/
+struct SolveOptions {
+
+	int max_calls = 1000000;
+    /**< Most recursive calls the solver may make. */
+
+	double max_ms = 0;
+    /**< Most milliseconds the solver may run for. */
+
+	int max_solutions = 0;
+    /**< Solver stops once it has found this many solutions. */
+
+	int min_words = 0;
+    /**< Fewest words a solution may have. */
+
+	int max_words = 0;
+    /**< Most words a solution may have. */
+
+	bool one_spangram = false;
+    /**< Only find solutions with at least one word touching two opposite
+	edges of the board, one of which can be the spangram every NYT 
+	Strands puzzle has. The others are theme words. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Why a search for solutions stopped.
+************************************************************************/
+enum SolveStop {
+	SOLVE_COMPLETE,
+    /**< Every solution was found. */
+	SOLVE_OUT_OF_CALLS,
+    /**< SolveOptions::max_calls ran out. */
+	SOLVE_OUT_OF_TIME,
+    /**< SolveOptions::max_ms ran out. */
+	SOLVE_ENOUGH_SOLUTIONS
+    /**< SolveOptions::max_solutions were found. */
+};
+
+
+/** **********************************************************************
+*  @brief
+*  What happened during the last search for solutions.
+************************************************************************/
+struct SolveStats {
+
+	SolveStop stop = SOLVE_COMPLETE;
+    /**< Why the search stopped. */
+
+	int calls = 0;
+    /**< Number of recursive calls made. */
+
+	int solutions = 0;
+    /**< Number of solutions found. */
+
+	double ms = 0;
+    /**< Milliseconds the search took. */
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  The solver checks its time limit once every this many recursive calls.
+************************************************************************/
+const int SOLVE_CLOCK_CALLS = 256;
+
+
+/** **********************************************************************
+*  @brief
+*  What the solver may still do under its SolveOptions. Shared by every
+*  thread solving a board, so once one thread runs out they all stop.
+************************************************************************/
+struct SolveBudget {
+
+	atomic<int> calls;
+    /**< Number of recursive calls made so far. */
+
+	atomic<int> solutions;
+    /**< Number of solutions found so far. */
+
+	int max_calls;
+    /**< Number of recursive calls allowed. */
+
+	int max_solutions;
+    /**< Number of solutions wanted. */
+
+	bool has_deadline;
+    /**< Whether there is a time limit. */
+
+	chrono::steady_clock::time_point deadline;
+    /**< When the time limit runs out. */
+
+	atomic<SolveStop> stop_reason;
+    /**< Set once a limit is reached. Every thread checks it. */
+
+	SolveBudget( const SolveOptions & options );
+
+	void spend();
+
+	void add_solution();
+
+	void stop( SolveStop reason );
+
+	bool spent() const;
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Exact cover solver using Knuth's dancing links. Each column is an
+*  item that has to be covered exactly once and each row is an option
+*  covering some of the items. Used to cover every letter of a board 
+*  with found words.
+************************************************************************/
+class DancingLinks {
+
+	public:
+
+		DancingLinks( int columns, int secondary = 0 );
+
+		void add_row( int row_id, const vector<int> & columns );
+
+		void search( vector<vector<int>> & solutions, SolveBudget & budget, int min_rows, int max_rows );
+
+	private:
+
+		vector<int> left;
+    	/**< Node to the left of each node. Node 0 is the root and nodes 1
+		to the number of columns are the column headers. */
+
+		vector<int> right;
+    	/**< Node to the right of each node. */
+
+		vector<int> up;
+    	/**< Node above each node. */
+
+		vector<int> down;
+    	/**< Node below each node. */
+
+		vector<int> column;
+    	/**< Column header of each node. */
+
+		vector<int> row;
+    	/**< Row id of each node, or -1 for the root and headers. */
+
+		vector<int> column_size;
+    	/**< Number of rows left in each column, by header node. */
+
+		int primary_columns;
+    	/**< Number of columns that have to be covered. The secondary
+		columns come after them. */
+
+		int columns_left;
+    	/**< Number of columns not covered yet. */
+
+		int shortest_row;
+    	/**< Fewest columns that have to be covered any row covers. */
+
+		int longest_row;
+    	/**< Most columns that have to be covered any row covers. */
+
+		vector<int> chosen;
+    	/**< Row ids of the working solution. */
+
+		void cover( int c );
+
+		void uncover( int c );
+
+		void search_rec( vector<vector<int>> & solutions, SolveBudget & budget, int min_rows, int max_rows );
+
+};
+
+
+/** **********************************************************************
+*  @brief
+*  Called with each word found on the board and the linearized positions
+*  of its letters. Returning false stops the search.
+************************************************************************/
+typedef function<bool( const string & word, const vector<uint16_t> & path )> WordVisitor;
+
+
+/** **********************************************************************
+*  @brief
+*  Working state of a search for words on the board.
+************************************************************************/
+template <typename Cells>
+struct WordSearch {
+
+	string word;
+    /**< Letters of the working word. */
+
+	vector<uint16_t> path;
+    /**< Positions of the working word on the board in order. */
+
+	Cells path_cells;
+    /**< Positions the working word covers. */
+
+	Cells blocked;
+    /**< Positions marked as used on the board. */
+
+	vector<SearchFrame> frames;
+    /**< Stack of the iterative search, one frame per letter of the
+	working word. */
+
+	int through = -1;
+    /**< Linearized position every found word has to cover, or -1. */
+
+	/** ******************************************************************
+	*  @brief
+	*  Hashes a found word together with the positions it covers.
+	********************************************************************/
+	struct FoundWordHash {
+		size_t operator()( const pair<string, Cells> & found ) const {
+			return hash<string>()( found.first ) ^ ( hash_cells( found.second ) * 0x9e3779b97f4a7c15ull );
+		}
+	};
+
+	unordered_set<pair<string, Cells>, FoundWordHash> already_found;
+    /**< Every word found so far together with the positions it covers. */
+
+	const WordVisitor * visitor = nullptr;
+    /**< Called with each found word instead of storing it, if set. */
+
+	bool stopped = false;
+    /**< Set once the visitor asks to stop the search. */
+
+	vector<PuzzleWord> found_words;
+    /**< Words found by this search when there is no visitor. */
+
+	vector<Cells> found_cells;
+    /**< Positions covered by each found word, in the same order as
+	found_words. */
+
+	/** ******************************************************************
+	*  @brief
+	*  Adds a found word, or passes it to the visitor, unless the same word
+	*  covering the same positions was already found. Returns whether the
+	*  word was new.
+	********************************************************************/
+	bool add_found_word( const string & found, const vector<uint16_t> & found_path, const Cells & cells ) {
+
+		// ensure we don't find two of the same word with the same letters in the same places
+		// however, it is fine if we find two of the same word but they share different shapes on the board
+		if( !already_found.emplace( found, cells ).second )
+			return false;
+
+		if( visitor ) {
+			stopped = !( *visitor )( found, found_path );
+			return true;
+		}
+
+		found_words.emplace_back( found, found_path );
+		found_cells.push_back( cells );
+		return true;
+
+	}
+
+};
+
+
 /** **********************************************************************
 *  @brief
 *  Represents the Strands board. Contains the text, words found on the board,
@@ -130,6 +846,8 @@ class StrandsBoard {
 
 		void set_board( char * new_board );
 
+		void set_letter( int x, int y, char letter );
+
 		int size();
 
 		bool in_bounds( int x, int y );
@@ -143,13 +861,9 @@ class StrandsBoard {
 		bool ** hint_coors;
     	/**< A 2d array representing which letters are in a hint. */
 
-		LetterNode prefix_tree;
-    	/**< Prefix tree of all english words with a length of at least 4 and
-		no non-letters. */
-
-		set<string> dictionary;
+		const Dictionary & dictionary;
     	/**< Dictionary of all english words with a length of at least 4 and 
-		no non-letters. */
+		no non-letters. Shared between every board. */
 
 
 		vector<PuzzleWord> found_words;
@@ -164,12 +878,33 @@ class StrandsBoard {
 		vector<PuzzleWord> possible_hints;
     	/**< Vector of words that match a hint. */
 
+		SearchEngine search_engine = SEARCH_ITERATIVE;
+    	/**< Whether find_all_words searches recursively or iteratively. */
+
+		SolveEngine solve_engine = SOLVE_BITMASK;
+    	/**< How find_solution_from_words searches for solutions. */
+
+		int search_threads = 1;
+    	/**< Number of threads find_all_words uses. 0 uses one per core.
+		Leave at 1 in builds without thread support. */
+
+		SolveOptions solve_options;
+    	/**< Limits on find_solution_from_words. */
+
+		SolveStats solve_stats;
+    	/**< What happened during the last find_solution_from_words. */
+
+		int solve_threads = 1;
+    	/**< Number of threads find_solution_from_words uses with 
+		SOLVE_BITMASK. 0 uses one per core. Leave at 1 in builds without 
+		thread support. */
+
 
 		void print_solutions( ostream & out = std::cout );
 		
 		void find_hint_matches( bool ** hint_coors, vector<PuzzleWord> & matching );
 		
-		void find_solution_from_words(); 
+		SolveStats find_solution_from_words(); 
 
 		void delete_word( string word );
 
@@ -179,17 +914,29 @@ class StrandsBoard {
 
 		void find_all_words(); 
 
+		void visit_all_words( const WordVisitor & visitor );
+
+		void find_longest_words( int amount, int min_length = MIN_WORD_LEN );
+
 		// interface code
 		PuzzleWord * get_found_word( int index );
 
 		int get_found_words_amount();
 
+		const vector<int> & words_at( int x, int y );
+
+		int get_cell_words_amount( int x, int y );
+
+		int get_cell_word( int x, int y, int index );
+
 		int get_solution_amount();
 
 		char * get_solution( int index );
     	
 		void set_used( int x, int y, int value );
 
+		void set_word_count( int min_words, int max_words );
+
     	void set_hint_coor( int x, int y, bool value );
 
     	PuzzleWord * get_hint( int index );
@@ -218,13 +965,103 @@ class StrandsBoard {
 		int curr_word_len;
     	/**< Length of the last word in the working solution. Not used.  */
 
-		int max_words = 9;
-    	/**< Maximum number of words in a solution. */
+		CellEngine cell_engine;
+    	/**< Type used as a set of positions, chosen from the board size. */
+
+		unique_ptr<Dictionary> board_dictionary;
+    	/**< Only the words of the dictionary that fit the letters of the
+		board. This is what the word search walks. */
+
+		string board_dictionary_text;
+    	/**< Text of the board board_dictionary was made for. */
+
+		const Dictionary * search_dictionary;
+    	/**< Dictionary the word search is walking. Either board_dictionary
+		or the shared dictionary. */
+
+		string board_text();
+
+		void fit_dictionary();
+
+		int min_word_length = MIN_WORD_LEN;
+    	/**< Shortest word the word search reports. Branches that can't
+		make a word this long are skipped. */
+
+		int ** neighbors;
+    	/**< For each linearized position, the linearized positions of the
+		letters touching it on the board, ended by a -1. */
+
+		void find_neighbors();
+
+		template <typename Cells>
+		void find_all_words_with( const WordVisitor & visitor, bool skip_used, int through );
+
+		template <typename Cells>
+		bool worth_following( const WordSearch<Cells> & search, int cell, uint32_t node, int length );
+
+		void visit_words( const WordVisitor & visitor, bool skip_used, int through = -1 );
+
+		vector<PuzzleWord> all_words;
+    	/**< Every word on the board, ignoring used letters, in order of
+		decreasing length. found_words is filled from this. */
+
+		string all_words_text;
+    	/**< Text of the board all_words was found for. */
+
+		vector<vector<int>> cell_words;
+    	/**< For each linearized position, the indicies in all_words of the
+		words covering it. */
+
+		vector<int> used_in_word;
+    	/**< For each word in all_words, how many of its letters are used. */
+
+		vector<bool> indexed_used;
+    	/**< Which letters were used when used_in_word was last updated. */
+
+		vector<vector<int>> found_cell_words;
+    	/**< For each linearized position, the indicies in found_words of
+		the words covering it. */
+
+		void index_found_words();
+
+		void index_all_words();
+
+		void update_used_index();
+
+		void index_words_by_cell();
+
+		void replace_letter( int x, int y, char letter );
+
+		template <typename Cells>
+		void find_all_words_from_point( WordSearch<Cells> & search, int cell, uint32_t node ); 
+
+		template <typename Cells>
+		void find_all_words_iterative( WordSearch<Cells> & search, int start );
+
+		template <typename Cells>
+		void find_solution_from_words_with( SolveBudget & budget );
+
+		void find_solution_dancing_links( SolveBudget & budget );
 
+		template <typename Cells>
+		int most_constrained_cell( const vector<Cells> & word_cells, const Cells & covered );
 
-		void find_all_words_from_point( char * word_str, int ** coors, set<string> & already_found, int x, int y, int word_len ); 
+		template <typename Cells>
+		int fill_region( const Cells & covered, int start, Cells & region );
 
-		void find_solution_from_words_rec( vector<int> & indicies, int total_chars, int & depth, int max_depth );
+		template <typename Cells>
+		void find_solution_from_words_rec( 
+			const vector<Cells> & word_cells,
+			Cells & covered,
+			vector<int> & indicies, 
+			int total_chars, 
+			int min_words,
+			int max_words,
+			int first_spangram,
+			bool partial,
+			SolveBudget & budget,
+			vector<vector<int>> & found
+		);
 
 
 };
@@ -241,7 +1078,12 @@ void solve_strands_new_word ( StrandsBoard & board, set<string> & words, LetterN
 void solve_strands_old_word( StrandsBoard & board, set<string> & words, LetterNode & wordtree, int x, int y, int chars_used );
 
 
-void get_words( set<string> & words, LetterNode & ln );
+void get_words( 
+	set<string> & words, 
+	LetterNode & ln, 
+	LetterArena & arena, 
+	const char * path = DICTIONARY_TEXT_FILE 
+);
 
 // main helpers
 int get_valid_int( const char * prompt_message, const char * error_message );
@@ -10,7 +10,7 @@
  *
  *  @par Description
  *  Default constructor. sets the width to 6 and height to 8, allocates
- *  all 2d arrays, and fills the dictionary.
+ *  all 2d arrays, and attaches the shared dictionary.
  *
  *  @par Example
  *  @verbatim
@@ -19,7 +19,7 @@
 
     @endverbatim
 ************************************************************************/
-StrandsBoard::StrandsBoard() {
+StrandsBoard::StrandsBoard() : dictionary( Dictionary::shared() ) {
 	width = 6;
 	height = 8;
 	allocate();
@@ -31,11 +31,20 @@ StrandsBoard::StrandsBoard() {
  *  @author Adam Wood
  *
  *  @par Description
- *  Allocates 2d arrays, sets default values, and fills the dictionary and 
- *  prefix tree.
+ *  Allocates 2d arrays and sets default values.
 ************************************************************************/
 void StrandsBoard::allocate() {
-	if ( size() == 0 ) return;
+	// an empty board has nothing to allocate but still has to be safe
+	// to search and to destroy
+	cell_engine = CELLS_64;
+	neighbors = nullptr;
+	if ( size() == 0 ) {
+		board = nullptr;
+		words = nullptr;
+		used = nullptr;
+		hint_coors = nullptr;
+		return;
+	}
 	// allocate the board with width + 1 for null terminator
 	board = alloc_2d_arr<char>( width + 1, height );
 	int max_words = width * height / 3 + 1;
@@ -47,8 +56,105 @@ void StrandsBoard::allocate() {
 	curr_word_len = 0;
 	used = alloc_2d_arr<bool>( width, height );
 	hint_coors = alloc_2d_arr<bool>( width, height );
+	// up to 8 neighbors per letter plus a -1 terminator
+	neighbors = alloc_2d_arr<int>( 9, size(), -1 );
+	find_neighbors();
+
+	// pick the smallest set of positions that fits the board
+	if ( size() <= 64 )
+		cell_engine = CELLS_64;
+	else if ( size() <= 128 )
+		cell_engine = CELLS_128;
+	else
+		cell_engine = CELLS_DYNAMIC;
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Fills the neighbors array with the positions touching each letter,
+ *  so the word search never has to step off the edge of the board.
+************************************************************************/
+void StrandsBoard::find_neighbors() {
+
+	int moves[][2] = {
+		{ 1, 0 },
+		{ -1, 0 },
+		{ 0, 1 },
+		{ 0, -1 },
+		{ 1, 1 },
+		{ 1, -1 },
+		{ -1, 1 },
+		{ -1, -1 }
+	};
+
+	for( int y = 0; y < height; y++ ) {
+		for ( int x = 0; x < width; x++ ) {
+
+			int * next = neighbors[ linearize_coor( x, y ) ];
+			for( auto move : moves )
+				if ( in_bounds( x + move[0], y + move[1] ) )
+					*next++ = linearize_coor( x + move[0], y + move[1] );
+
+		}
+	}
+
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the letters of the board row by row as one string.
+ *
+ *  @returns the text of the board with no whitespace.
+************************************************************************/
+string StrandsBoard::board_text() {
+	string text;
+	text.reserve( size() );
+	for( int y = 0; y < height; y++ )
+		text.append( board[y], width );
+	return text;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Makes board_dictionary hold only the words that fit the letters of
+ *  the board, unless it was already made for the current text of the
+ *  board. Used letters are ignored so marking words doesn't require a
+ *  new dictionary.
+************************************************************************/
+void StrandsBoard::fit_dictionary() {
+
+	string text = board_text();
+	if ( board_dictionary && text == board_dictionary_text ) return;
+
+	BoardLetters letters = {};
+
+	for( int y = 0; y < height; y++ ) {
+		for ( int x = 0; x < width; x++ ) {
 
-	get_words( dictionary, prefix_tree );
+			int c = board[y][x] - 'a';
+			if ( c < 0 || c >= 26 ) continue;
+			letters.counts[c]++;
+
+			for( int * next = neighbors[ linearize_coor( x, y ) ]; *next != -1; next++ ) {
+				int n = board[ *next / width ][ *next % width ] - 'a';
+				if ( n >= 0 && n < 26 ) letters.follows[c] |= 1u << n;
+			}
+
+		}
+	}
+
+	board_dictionary = make_unique<Dictionary>( dictionary, letters );
+	board_dictionary_text = std::move( text );
 
 }
 
@@ -72,7 +178,7 @@ void StrandsBoard::allocate() {
 
     @endverbatim
 ************************************************************************/
-StrandsBoard::StrandsBoard( int w, int h ) {
+StrandsBoard::StrandsBoard( int w, int h ) : dictionary( Dictionary::shared() ) {
 	width = w;
 	height = h;
 	allocate();	
@@ -102,7 +208,8 @@ StrandsBoard::StrandsBoard( int w, int h ) {
 
     @endverbatim
 ************************************************************************/
-StrandsBoard::StrandsBoard( vector<string> & board_string ) {
+StrandsBoard::StrandsBoard( vector<string> & board_string ) 
+	: dictionary( Dictionary::shared() ) {
 
 	// get width and height from the size of the vector
 	height = (int) board_string.size();
@@ -130,6 +237,7 @@ StrandsBoard::~StrandsBoard() {
 	free_2d<char>( words );
 	free_2d<bool>( used );
 	free_2d<bool>( hint_coors );
+	free_2d<int>( neighbors );
 }
 
 
@@ -170,9 +278,9 @@ int StrandsBoard::size() {
  *  @par Example
  *  @verbatim
 
-	//inside of find_all_words_from_point we return if we are out of bounds
-    if ( !in_bounds( x, y ) || used[y][x] 
-	|| !prefix_tree.contains( word_str ) ) return;
+	// inside of find_neighbors we skip positions off the board
+	if ( in_bounds( x + move[0], y + move[1] ) )
+		*next++ = linearize_coor( x + move[0], y + move[1] );
 
     @endverbatim
 ************************************************************************/
@@ -216,7 +324,9 @@ int StrandsBoard::linearize_coor( int x, int y ) {
  *  @par Description
  *  Sets the text of the board given a 1d string with no whitespace.
  *  If the string's length is not the size() of the board, the function
- *  just returns.
+ *  just returns. If no more than MAX_LETTER_EDITS letters changed and
+ *  every word was already found, the changed letters are searched
+ *  through one at a time and the words are indexed once at the end.
  *
  *  @param[in] new_board c style string representing the text of the board.
  *
@@ -238,6 +348,22 @@ void StrandsBoard::set_board( char * new_board ) {
 	if( int( strlen( new_board ) ) != size() )
 		return;
 
+	// when only a few letters changed, edit them one at a time so the
+	// words on the rest of the board don't have to be found again
+	int changed = 0;
+	for( int i = 0; i < size(); i++ )
+		changed += new_board[i] != board[ i / width ][ i % width ];
+
+	bool indexed = !all_words_text.empty() && board_text() == all_words_text;
+	if ( indexed && changed > 0 && changed <= MAX_LETTER_EDITS ) {
+		for( int i = 0; i < size(); i++ )
+			if ( new_board[i] != board[ i / width ][ i % width ] )
+				replace_letter( i % width, i / width, new_board[i] );
+		index_words_by_cell();
+		all_words_text = board_text();
+		return;
+	}
+
 	// copy the string over
 	for( int i = 0; i < height; i ++ )
 		memcpy( board[i], new_board + i * width, width * sizeof( char ) );
@@ -294,6 +420,87 @@ int StrandsBoard::get_found_words_amount() {
 
 
 
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns the indicies in found_words of the words covering a position
+ *  on the board. Kept up to date by StrandsBoard::find_all_words and
+ *  StrandsBoard::find_longest_words.
+ *
+ *  @param[in] x the x position.
+ *  @param[in] y the y position.
+ *
+ *  @returns the indicies of the words covering (x,y) in increasing order.
+ *
+ *  @par Example
+ *  @verbatim
+
+	for( auto index : board.words_at( 2, 3 ) )
+		cout << board.found_words[ index ].word << endl;
+
+    @endverbatim
+************************************************************************/
+const vector<int> & StrandsBoard::words_at( int x, int y ) {
+	static const vector<int> none;
+	int cell = linearize_coor( x, y );
+	if ( !in_bounds( x, y ) || cell >= int( found_cell_words.size() ) ) return none;
+	return found_cell_words[ cell ];
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Get the number of found words covering a position on the board.
+ *
+ *  @param[in] x the x position.
+ *  @param[in] y the y position.
+ *
+ *  @returns the number of words covering (x,y).
+ *
+ *  @par Example
+ *  @verbatim
+
+    for( int i = 0; i < get_cell_words_amount( x, y ); i++ ) {
+		cout << get_found_word( get_cell_word( x, y, i ) )->word << endl;
+	}
+
+    @endverbatim
+************************************************************************/
+int StrandsBoard::get_cell_words_amount( int x, int y ) {
+	return static_cast<int>( words_at( x, y ).size() );
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Get the index in found_words of one of the words covering a position
+ *  on the board.
+ *
+ *  @param[in] x the x position.
+ *  @param[in] y the y position.
+ *  @param[in] index which of the words covering (x,y) to get.
+ *
+ *  @returns the index of the word in found_words.
+ *
+ *  @par Example
+ *  @verbatim
+
+    for( int i = 0; i < get_cell_words_amount( x, y ); i++ ) {
+		cout << get_found_word( get_cell_word( x, y, i ) )->word << endl;
+	}
+
+    @endverbatim
+************************************************************************/
+int StrandsBoard::get_cell_word( int x, int y, int index ) {
+	return words_at( x, y )[ index ];
+}
+
+
 /** **********************************************************************
  *  @author Adam Wood
  *
@@ -377,6 +584,34 @@ void StrandsBoard::set_used( int x, int y, int value ) {
 }
 
 
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Sets how many words solutions found by find_solution_from_words may 
+ *  have, such as the number of theme words the puzzle states plus its
+ *  spangram. The solver skips any branch that can't end up with that
+ *  many words.
+ *
+ *  @param[in] min_words the fewest words a solution may have.
+ *  @param[in] max_words the most words a solution may have, or 0 for
+ *  no limit.
+ *
+ *  @par Example
+ *  @verbatim
+
+	// 6 theme words and the spangram
+	board.set_word_count( 7, 7 );
+	board.find_solution_from_words();
+
+    @endverbatim
+************************************************************************/
+void StrandsBoard::set_word_count( int min_words, int max_words ) {
+	solve_options.min_words = min_words;
+	solve_options.max_words = max_words;
+}
+
+
 /** **********************************************************************
  *  @author Adam Wood
  *
@@ -4,6 +4,7 @@
 using namespace Catch;
 
 set<string> words;
+LetterArena arena;
 LetterNode wordtree;
 
 TEST_CASE("StrandsBoard") {
@@ -27,8 +28,266 @@ TEST_CASE("StrandsBoard") {
 	solve_strands( sb, words, wordtree ); 
 }
 
+TEST_CASE("Dictionary") {
+	const Dictionary & dict = Dictionary::shared();
+
+	REQUIRE( &dict == &Dictionary::shared() );
+	REQUIRE( dict.contains( "nirvana" ) );
+	REQUIRE( dict.has_prefix( "nirv" ) );
+	REQUIRE( !dict.contains( "nirv" ) );
+
+	StrandsBoard a( 6, 8 );
+	StrandsBoard b( 6, 8 );
+	REQUIRE( &a.dictionary == &b.dictionary );
+}
+
+/** **********************************************************************
+ *  @brief
+ *  The words on a board as found by searching it, with each word's path.
+************************************************************************/
+set<pair<string, vector<int>>> searched_words( StrandsBoard & sb ) {
+	set<pair<string, vector<int>>> result;
+	sb.visit_all_words( [&]( const string & word, const vector<uint16_t> & path ) {
+		result.insert( { word, vector<int>( path.begin(), path.end() ) } );
+		return true;
+	} );
+	return result;
+}
+
+/** **********************************************************************
+ *  @brief
+ *  The words in found_words, with each word's path.
+************************************************************************/
+set<pair<string, vector<int>>> found_word_set( StrandsBoard & sb ) {
+	set<pair<string, vector<int>>> result;
+	for( auto & puzzle_word : sb.found_words )
+		result.insert( { puzzle_word.word, vector<int>( puzzle_word.path.begin(), puzzle_word.path.end() ) } );
+	return result;
+}
+
+TEST_CASE("find_all_words - used letters") {
+	vector<string> b = {
+		"rconna",
+		"qoksav",
+		"ueebir",
+		"tnhaoi",
+		"rejnpn",
+		"aruods",
+		"nsiorh",
+		"eysaus"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+	REQUIRE( found_word_set( sb ) == searched_words( sb ) );
+
+	// mark the longest word as used, then unmark it again
+	vector<int> path( sb.found_words[0].path.begin(), sb.found_words[0].path.end() );
+	for( auto cell : path )
+		sb.set_used( cell % 6, cell / 6, 1 );
+	sb.find_all_words();
+	REQUIRE( found_word_set( sb ) == searched_words( sb ) );
+
+	for( auto cell : path )
+		sb.set_used( cell % 6, cell / 6, 0 );
+	sb.find_all_words();
+	REQUIRE( found_word_set( sb ) == searched_words( sb ) );
+}
+
+TEST_CASE("set_letter") {
+	vector<string> b = {
+		"leaesp",
+		"apcmae",
+		"ikorrr",
+		"retqro",
+		"tgntus",
+		"eieeir",
+		"vremio",
+		"skatrr"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+
+	sb.set_letter( 2, 3, 'a' );
+	sb.find_all_words();
+	REQUIRE( found_word_set( sb ) == searched_words( sb ) );
+
+	// a few letters at once go through set_board
+	string text;
+	for( auto & row : b )
+		text += row;
+	text[0] = 's';
+	text[21] = 'e';
+	text[40] = 'n';
+	sb.set_board( text.data() );
+	sb.find_all_words();
+	REQUIRE( found_word_set( sb ) == searched_words( sb ) );
+}
+
+/** **********************************************************************
+ *  @brief
+ *  The solutions found last on a board, each with its words sorted.
+************************************************************************/
+set<vector<int>> solution_set( StrandsBoard & sb ) {
+	set<vector<int>> result;
+	for( auto solution : sb.solutions ) {
+		sort( solution.begin(), solution.end() );
+		result.insert( solution );
+	}
+	return result;
+}
+
+TEST_CASE("find_solution_from_words - used letters") {
+	vector<string> b = {
+		"euttel",
+		"cnorke",
+		"bckluy",
+		"saceth",
+		"maipct",
+		"andwio",
+		"ynnsma",
+		"oaieto"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+
+	// mark a word of a solution as used, splitting the rest of the board
+	sb.find_solution_from_words();
+	REQUIRE( !sb.solutions.empty() );
+	for( auto cell : sb.found_words[ sb.solutions[0][0] ].path )
+		sb.set_used( cell % 6, cell / 6, 1 );
+	sb.find_all_words();
+
+	sb.solve_engine = SOLVE_DANCING_LINKS;
+	sb.find_solution_from_words();
+	auto expected = solution_set( sb );
+	REQUIRE( !expected.empty() );
+
+	sb.solve_engine = SOLVE_BITMASK;
+	sb.find_solution_from_words();
+	REQUIRE( solution_set( sb ) == expected );
+}
+
+TEST_CASE("find_solution_from_words - limits") {
+	vector<string> b = {
+		"rconna",
+		"qoksav",
+		"ueebir",
+		"tnhaoi",
+		"rejnpn",
+		"aruods",
+		"nsiorh",
+		"eysaus"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+
+	SolveStats stats = sb.find_solution_from_words();
+	REQUIRE( stats.stop == SOLVE_COMPLETE );
+	REQUIRE( stats.solutions == int( sb.solutions.size() ) );
+	REQUIRE( sb.solutions.size() > 10 );
+
+	sb.solve_options.max_solutions = 10;
+	stats = sb.find_solution_from_words();
+	REQUIRE( stats.stop == SOLVE_ENOUGH_SOLUTIONS );
+	REQUIRE( sb.solutions.size() == 10 );
+
+	sb.solve_options.max_solutions = 0;
+	sb.solve_options.max_calls = 10;
+	stats = sb.find_solution_from_words();
+	REQUIRE( stats.stop == SOLVE_OUT_OF_CALLS );
+}
+
+TEST_CASE("find_solution_from_words - one spangram") {
+	vector<string> b = {
+		"euttel",
+		"cnorke",
+		"bckluy",
+		"saceth",
+		"maipct",
+		"andwio",
+		"ynnsma",
+		"oaieto"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+
+	// the solutions with a word that could be the spangram, found
+	// without the option
+	sb.find_solution_from_words();
+	set<vector<int>> expected;
+	for( auto & solution : solution_set( sb ) ) {
+		int spangrams = 0;
+		for( auto index : solution )
+			spangrams += sb.found_words[index].spangram();
+		if ( spangrams >= 1 )
+			expected.insert( solution );
+	}
+	REQUIRE( !expected.empty() );
+
+	// the real answer, where lettuce runs along the top row
+	set<string> answer = { "mayonnaise", "sandwich", "lettuce", "tomato", "turkey", "pickle", "bacon" };
+	auto has_answer = [&]() {
+		for( auto & solution : sb.solutions ) {
+			set<string> solution_words;
+			for( auto index : solution )
+				solution_words.insert( sb.found_words[index].word );
+			if ( solution_words == answer ) return true;
+		}
+		return false;
+	};
+
+	sb.solve_options.one_spangram = true;
+	sb.find_solution_from_words();
+	REQUIRE( solution_set( sb ) == expected );
+	REQUIRE( has_answer() );
+
+	sb.solve_engine = SOLVE_DANCING_LINKS;
+	sb.find_solution_from_words();
+	REQUIRE( solution_set( sb ) == expected );
+	REQUIRE( has_answer() );
+}
+
+TEST_CASE("find_solution_from_words - word count") {
+	vector<string> b = {
+		"euttel",
+		"cnorke",
+		"bckluy",
+		"saceth",
+		"maipct",
+		"andwio",
+		"ynnsma",
+		"oaieto"
+	};
+
+	StrandsBoard sb( b );
+	sb.find_all_words();
+	sb.find_solution_from_words();
+	auto every_solution = solution_set( sb );
+
+	for( int count = 5; count <= 9; count++ ) {
+		set<vector<int>> expected;
+		for( auto & solution : every_solution )
+			if ( int( solution.size() ) == count )
+				expected.insert( solution );
+
+		sb.set_word_count( count, count );
+		sb.solve_engine = SOLVE_BITMASK;
+		sb.find_solution_from_words();
+		REQUIRE( solution_set( sb ) == expected );
+
+		sb.solve_engine = SOLVE_DANCING_LINKS;
+		sb.find_solution_from_words();
+		REQUIRE( solution_set( sb ) == expected );
+	}
+}
+
 TEST_CASE("todays") {
-	get_words(words, wordtree);
+	get_words(words, wordtree, arena);
 	vector<string> b = {
 		"rconna",
 		"qoksav",
@@ -41,13 +300,13 @@ TEST_CASE("todays") {
 	};
 
 	StrandsBoard sb( b );
-	sb.max_words = 10;
+	sb.solve_options.max_words = 10;
 
 	solve_strands( sb, words, wordtree );
 }
 
 TEST_CASE("find_all_words") {
-	get_words(words, wordtree);
+	get_words(words, wordtree, arena);
 	vector<PuzzleWord> found;
 	vector<string> b = {
 		"rconna",
@@ -90,7 +349,7 @@ TEST_CASE("find_all_words") {
 }
 
 TEST_CASE("find_all_words - todays") {
-	get_words(words, wordtree);
+	get_words(words, wordtree, arena);
 	vector<PuzzleWord> found;
 	vector<string> b = {
 		"euttel",
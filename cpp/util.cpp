@@ -1,6 +1,7 @@
 /** **********************************************************************
 * @file
-* @brief contains implementation of the LetterNode struct and get_words.
+* @brief contains implementation of the LetterNode struct, the LetterArena
+* class and get_words.
 *************************************************************************/
 #include "strands.h"
 
@@ -63,7 +64,8 @@ LetterNode * & LetterNode::operator []( char c ) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Constructor for the LetterNode struct. Sets all of the children to nullptr.
+ *  Constructor for the LetterNode struct. Sets all of the children to nullptr
+ *  and marks the node as not ending a word.
  *
  *  @par Example
  *  @verbatim
@@ -74,6 +76,7 @@ LetterNode * & LetterNode::operator []( char c ) {
 ************************************************************************/
 LetterNode::LetterNode() {
 	memset( children, 0, LETTER_NODE_MAX * sizeof( LetterNode * ) );
+	terminal = false;
 }
 
 
@@ -81,11 +84,84 @@ LetterNode::LetterNode() {
  *  @author Adam Wood
  *
  *  @par Description
- *  Deconstructs the LetterNode and all of its children.
+ *  Constructs an empty arena. No memory is allocated until the first
+ *  node is requested.
+ *
+ *  @par Example
+ *  @verbatim
+
+    LetterArena arena;
+	LetterNode prefix_tree;
+	prefix_tree.insert( "nirvana", arena );
+
+    @endverbatim
+************************************************************************/
+LetterArena::LetterArena() {
+	block_size = 0;
+	block_used = 0;
+	total = 0;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Frees every node handed out by the arena. Only one delete is needed
+ *  per block rather than one per node.
+************************************************************************/
+LetterArena::~LetterArena() {
+	for( auto block : blocks )
+		delete [] block;
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Hands out a new empty node. A new block twice the size of the last
+ *  one is allocated when the current block runs out.
+ *
+ *  @returns a pointer to the new node, which lives as long as the arena.
+ *
+ *  @par Example
+ *  @verbatim
+
+    LetterNode * nln = arena.allocate();
+	(*ln)[c] = nln;
+	ln = nln;
+
+    @endverbatim
+************************************************************************/
+LetterNode * LetterArena::allocate() {
+
+	if ( block_used == block_size ) {
+		block_size = blocks.empty() ? 4096 : block_size * 2;
+		LetterNode * block = new (nothrow) LetterNode [ block_size ];
+		if ( block == nullptr ) {
+			std::cerr << "Failed to allocate memory\n";
+			exit ( 1 );
+		}
+		blocks.push_back( block );
+		block_used = 0;
+	}
+
+	total++;
+	return &blocks.back()[ block_used++ ];
+}
+
+
+/** **********************************************************************
+ *  @author Adam Wood
+ *
+ *  @par Description
+ *  Returns how many nodes the arena has handed out.
+ *
+ *  @returns the number of nodes allocated from the arena.
 ************************************************************************/
-LetterNode::~LetterNode( ) {
-	for( auto & ln : children ) 
-		if ( ln != nullptr ) delete ln;
+size_t LetterArena::size() const {
+	return total;
 }
 
 
@@ -110,11 +186,11 @@ LetterNode::~LetterNode( ) {
 
     @endverbatim
 ************************************************************************/
-bool LetterNode::contains( string word ) {
-	LetterNode * ln = this;
+bool LetterNode::contains( const string & word ) const {
+	const LetterNode * ln = this;
 	for( auto c : word ) {
-		if( (*ln)[c] == nullptr ) return false;
-		ln = (*ln)[c];
+		ln = ln->children[ char_to_index( c ) ];
+		if( ln == nullptr ) return false;
 	}
 	return true;
 }
@@ -124,13 +200,16 @@ bool LetterNode::contains( string word ) {
  *  @author Adam Wood
  *
  *  @par Description
- *  Add a word to the prefix tree.
+ *  Add a word to the prefix tree. The node of the last letter is marked
+ *  as ending a word.
  *
  *  @param[in] word the word to add to the prefix tree.
+ *  @param[in,out] arena where to allocate new nodes from.
  *
  *  @par Example
  *  @verbatim
 
+	LetterArena arena;
 	LetterNode ln;
 
     while ( wfile >> temp ) {
@@ -144,22 +223,23 @@ bool LetterNode::contains( string word ) {
 		// dont bother with a short word
 		if ( temp.size() < 3 ) continue;
 
-		ln.insert( temp );
+		ln.insert( temp, arena );
 	}
 
     @endverbatim
 ************************************************************************/
-void LetterNode::insert( string word ) {
+void LetterNode::insert( const string & word, LetterArena & arena ) {
 	LetterNode * ln = this;
 	for( auto c : word ) {
 		if ( (*ln)[c] != nullptr ) {
 			ln = (*ln)[c];
 			continue;
 		}
-		LetterNode * nln = new (nothrow) LetterNode;
+		LetterNode * nln = arena.allocate();
 		(*ln)[c] = nln;
 		ln = nln;
 	}
+	ln->terminal = true;
 }
 
 
@@ -172,22 +252,28 @@ void LetterNode::insert( string word ) {
  *
  *  @param[out] words the set of strings to add words to.
  *  @param[out] ln the LetterNode prefix tree to add words to.
+ *  @param[in,out] arena where to allocate the nodes of the prefix tree.
+ *  @param[in] path the location of the words file.
  *
  *  @par Example
  *  @verbatim
 
+	LetterArena arena;
 	LetterNode prefix_tree;
 	set<string> dictionary;
 
-    get_words( dictionary, prefix_tree );
+    get_words( dictionary, prefix_tree, arena );
 
     @endverbatim
 ************************************************************************/
-void get_words( set<string> & words, LetterNode & ln ) {
+void get_words( set<string> & words, LetterNode & ln, LetterArena & arena, const char * path ) {
 
-	ifstream wfile( "words" );
+	ifstream wfile( path );
 
-	if( !wfile.is_open() ) exit ( 1 );
+	if( !wfile.is_open() ) {
+		std::cerr << "Could not open the words file " << path << "\n";
+		exit ( 1 );
+	}
 
 	string temp;
 	string plural;
@@ -200,8 +286,12 @@ void get_words( set<string> & words, LetterNode & ln ) {
 		for( auto & c : temp )
 			c = static_cast<char>( tolower( c ) );
 
-		// dont bother with a short word
-		if ( temp.size() < 3 ) continue;
+		// dont bother with a short word or one that can't be spelled
+		// with the letters on a board
+		if ( static_cast<int>( temp.size() ) < MIN_WORD_LEN ) continue;
+		if ( any_of( temp.begin(), temp.end(), []( char c ) { 
+			return c < 'a' || c > 'z'; 
+		} ) ) continue;
 
 		// create a naively spelled plural of a word
 		// even if that does not make sense
@@ -209,7 +299,7 @@ void get_words( set<string> & words, LetterNode & ln ) {
 		//words.insert( plural );
 		words.insert( temp );
 		//ln.insert( plural );
-		ln.insert( temp );
+		ln.insert( temp, arena );
 	}
 
 	wfile.close();
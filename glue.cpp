@@ -82,6 +82,10 @@ void EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_set_hint_coor_3(StrandsBo
   self->set_hint_coor(x, y, value);
 }
 
+void EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_set_word_count_2(StrandsBoard* self, int min_words, int max_words) {
+  self->set_word_count(min_words, max_words);
+}
+
 PuzzleWord* EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_get_found_word_1(StrandsBoard* self, int index) {
   return self->get_found_word(index);
 }
@@ -90,6 +94,14 @@ int EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_get_found_words_amount_0(S
   return self->get_found_words_amount();
 }
 
+int EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_get_cell_words_amount_2(StrandsBoard* self, int x, int y) {
+  return self->get_cell_words_amount(x, y);
+}
+
+int EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_get_cell_word_3(StrandsBoard* self, int x, int y, int index) {
+  return self->get_cell_word(x, y, index);
+}
+
 int EMSCRIPTEN_KEEPALIVE emscripten_bind_StrandsBoard_get_solution_amount_0(StrandsBoard* self) {
   return self->get_solution_amount();
 }
@@ -315,6 +315,14 @@ StrandsBoard.prototype['set_hint_coor'] = StrandsBoard.prototype.set_hint_coor =
   _emscripten_bind_StrandsBoard_set_hint_coor_3(self, x, y, value);
 };
 
+/** @suppress {undefinedVars, duplicate} @this{Object} */
+StrandsBoard.prototype['set_word_count'] = StrandsBoard.prototype.set_word_count = function(min_words, max_words) {
+  var self = this.ptr;
+  if (min_words && typeof min_words === 'object') min_words = min_words.ptr;
+  if (max_words && typeof max_words === 'object') max_words = max_words.ptr;
+  _emscripten_bind_StrandsBoard_set_word_count_2(self, min_words, max_words);
+};
+
 /** @suppress {undefinedVars, duplicate} @this{Object} */
 StrandsBoard.prototype['get_found_word'] = StrandsBoard.prototype.get_found_word = function(index) {
   var self = this.ptr;
@@ -328,6 +336,23 @@ StrandsBoard.prototype['get_found_words_amount'] = StrandsBoard.prototype.get_fo
   return _emscripten_bind_StrandsBoard_get_found_words_amount_0(self);
 };
 
+/** @suppress {undefinedVars, duplicate} @this{Object} */
+StrandsBoard.prototype['get_cell_words_amount'] = StrandsBoard.prototype.get_cell_words_amount = function(x, y) {
+  var self = this.ptr;
+  if (x && typeof x === 'object') x = x.ptr;
+  if (y && typeof y === 'object') y = y.ptr;
+  return _emscripten_bind_StrandsBoard_get_cell_words_amount_2(self, x, y);
+};
+
+/** @suppress {undefinedVars, duplicate} @this{Object} */
+StrandsBoard.prototype['get_cell_word'] = StrandsBoard.prototype.get_cell_word = function(x, y, index) {
+  var self = this.ptr;
+  if (x && typeof x === 'object') x = x.ptr;
+  if (y && typeof y === 'object') y = y.ptr;
+  if (index && typeof index === 'object') index = index.ptr;
+  return _emscripten_bind_StrandsBoard_get_cell_word_3(self, x, y, index);
+};
+
 /** @suppress {undefinedVars, duplicate} @this{Object} */
 StrandsBoard.prototype['get_solution_amount'] = StrandsBoard.prototype.get_solution_amount = function() {
   var self = this.ptr;